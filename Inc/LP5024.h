@@ -11,6 +11,9 @@
  ******************************************************************************
  */
 
+#ifndef CUSTOM_DRIVERS_INC_LP5024_H_
+#define CUSTOM_DRIVERS_INC_LP5024_H_
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -24,9 +27,6 @@ extern "C"
 	 * @{
 	 */
 
-#ifndef CUSTOM_DRIVERS_INC_LP5024_H_
-#define CUSTOM_DRIVERS_INC_LP5024_H_
-
 #define STM32F1 // Select MCU
 
 // Includes
@@ -68,6 +68,20 @@ extern "C"
 #define LP5024_I2C_TIMEOUT (100)	  ///< Time before I2C timeout [ms].
 #define LP5024_I2C_MAX_ATTEMPTS (3)	  ///< Number of attempts, before error.
 #define LP5024_I2C_ATTEMPT_DELAY (10) ///< Time between attempts [ms].
+#ifndef LP5024_MAX_BUS_GUARDS
+#define LP5024_MAX_BUS_GUARDS (4) ///< Max. number of guarded I2C units.
+#endif
+#ifndef LP5024_MAX_TRANSFER_HOOKS
+#define LP5024_MAX_TRANSFER_HOOKS (4) ///< Max. number of transfer observers.
+#endif
+
+#ifndef LP5024_TIMESTAMP
+#define LP5024_TIMESTAMP() HAL_GetTick() ///< Timestamp source for statistics.
+#define LP5024_TIMESTAMP_HZ (1000)		 ///< Resolution of timestamp source [Hz].
+#endif
+#ifndef LP5024_CYCLES
+#define LP5024_CYCLES() (0) ///< Cycle counter for cost statistics, e.g. DWT->CYCCNT.
+#endif
 
 // Error codes
 #define LP5024_SUCCESS (0)		   ///< Error code for success.
@@ -84,6 +98,14 @@ extern "C"
  * A0=Vdd, A1=Vdd -> 0b11
  */
 #define LP5024_ADDRESS (0x28)
+/** Part descriptor of a device, LP5024 if none is set. */
+#define LP5024_PART(device) ((device)->part != NULL ? (device)->part : &LP5024_Parts[LP5024_LP5024])
+/** Shifted 8Bit I2C address of a device, as expected by the HAL. */
+#define LP5024_I2C_ADDRESS(device) ((LP5024_PART(device)->address + (device)->a0) << 1)
+/** 1 if a device has the register layout of LP5018 and LP5024, which the LP5024_REG_ addresses describe. */
+#define LP5024_NATIVE_LAYOUT(device) (LP5024_PART(device)->regReset == LP5024_REG_COUNT)
+/** Register shadow of a device, NULL if none is set or the register layout differs from LP5018 and LP5024. */
+#define LP5024_SHADOW(device) (LP5024_NATIVE_LAYOUT(device) ? (device)->shadow : NULL)
 
 // Register addresses
 #define LP5024_REG_ENABLE (0x00) ///< Device enable register.
@@ -134,6 +156,33 @@ extern "C"
 
 #define LP5024_REG_RESET (0x27) ///< Reset register.
 
+#define LP5024_REG_COUNT (0x27) ///< Number of registers holding state (0x00..0x26).
+
+#define LP5024_RGBLED_COUNT (8) ///< Number of RGB LEDs.
+#define LP5024_LED_COUNT (24)	///< Number of LEDs (OUTx registers).
+
+#define LP5024_MAX_RGBLED_COUNT (12) ///< Max. number of RGB LEDs within the LP50xx family.
+#define LP5024_MAX_LED_COUNT (36)	 ///< Max. number of LEDs within the LP50xx family.
+
+#define LP5024_STAGE_REG_COUNT (0x38) ///< Registers below the reset register of the largest part.
+#define LP5024_STAGE_MERGE_GAP (2)	  ///< Largest gap between staged registers that is filled from the shadow.
+
+/**
+ * Writes colour of one RGB LED into a register image, map is a lp5024_ChannelMap_t.
+ */
+#define LP5024_PUT_RGB(led, map, r, g, b) \
+	do                                    \
+	{                                     \
+		(led)[(map)->red] = (r);          \
+		(led)[(map)->green] = (g);        \
+		(led)[(map)->blue] = (b);         \
+	} while (0)
+
+/** Bit masks with one bit per chip handle, stored in an array of uint32_t. */
+#define LP5024_MASK_MARK(mask, handle) ((mask)[(handle) >> 5] |= 1UL << ((handle) & 31))
+#define LP5024_MASK_CLEAR(mask, handle) ((mask)[(handle) >> 5] &= ~(1UL << ((handle) & 31)))
+#define LP5024_MASK_IS_MARKED(mask, handle) ((mask)[(handle) >> 5] & (1UL << ((handle) & 31)))
+
 	/**
 	 * @brief Enum for last two bits of device address.
 	 */
@@ -239,6 +288,15 @@ extern "C"
 		LP5024_BGR,
 		LP5024_BRG,
 	} lp5024_ColorOrder_t;
+	/**
+	 * @brief Struct for register offsets of the colours within one RGB LED.
+	 */
+	typedef struct
+	{
+		uint8_t red;
+		uint8_t green;
+		uint8_t blue;
+	} lp5024_ChannelMap_t;
 	/**
 	 * @brief Enum for RGB LEDs.
 	 *
@@ -295,6 +353,95 @@ extern "C"
 		LP5024_LED_On
 	} lp5024_LED_OnOff_t;
 
+	/**
+	 * @brief Enum for power down of idle devices.
+	 *
+	 */
+	typedef enum
+	{
+		LP5024_IdleStayOn,	   ///< No power down.
+		LP5024_IdlePowerSave,  ///< Enables automatic power save while idle.
+		LP5024_IdleChipDisable ///< Clears Chip_EN while idle.
+	} lp5024_IdleMode_t;
+
+	/**
+	 * @brief Struct for expected register state of a device.
+	 * Kept up to date by every write of the driver, when attached to a device.
+	 */
+	typedef struct
+	{
+		uint8_t reg[LP5024_REG_COUNT]; ///< Register values as written.
+		lp5024_IdleMode_t idleMode;	   ///< Power down of idle device.
+		uint32_t idleTimeout;		   ///< Time with black outputs before power down [timestamp ticks].
+		uint32_t lastActivity;		   ///< Timestamp of last write.
+		uint8_t asleep;				   ///< Device powered down by the driver.
+		uint32_t sleeps;			   ///< Number of power downs.
+		uint32_t powerTransactions;	   ///< Transactions caused by power downs and wake ups.
+		uint32_t wakeLatency;		   ///< Worst duration of a wake up [timestamp ticks].
+		uint32_t busEpoch;			   ///< Bus recoveries already restored to the chip.
+	} lp5024_Shadow_t;
+
+	/**
+	 * @brief Enum for parts of the LP50xx family.
+	 */
+	typedef enum
+	{
+		LP5024_LP5009,
+		LP5024_LP5012,
+		LP5024_LP5018,
+		LP5024_LP5024,
+		LP5024_LP5030,
+		LP5024_LP5036
+	} lp5024_PartNumber_t;
+
+	/**
+	 * @brief Struct for register layout and size of one part of the LP50xx family.
+	 */
+	typedef struct
+	{
+		uint8_t address;		   ///< Device address without address pins (7Bit Form).
+		uint8_t rgbLEDs;		   ///< Number of RGB LEDs.
+		uint8_t regEnable;		   ///< Device enable register (DEVICE_CONFIG0).
+		uint8_t regConfig;		   ///< Configuration register (DEVICE_CONFIG1).
+		uint8_t regLEDConf;		   ///< First LED configuration register, 8 RGB LEDs per register.
+		uint8_t regBankBrightness; ///< Total brightness register.
+		uint8_t regBankA;		   ///< Bank A colour register, followed by bank B and C.
+		uint8_t regRGBBrightness;  ///< RGB LED 0 brightness register.
+		uint8_t regLED;			   ///< LED 0 brightness register (OUT0).
+		uint8_t regReset;		   ///< Reset register.
+	} lp5024_Part_t;
+
+	/**
+	 * @brief Struct for timeout and retry policy of the register transactions.
+	 */
+	typedef struct
+	{
+		uint32_t timeout;	   ///< Time before I2C timeout [ms].
+		uint8_t attempts;	   ///< Number of attempts, before error.
+		uint32_t attemptDelay; ///< Time between attempts [ms].
+	} lp5024_Policy_t;
+
+	/**
+	 * @brief Struct for staging statistics.
+	 */
+	typedef struct
+	{
+		uint32_t writes;	   ///< Write calls staged.
+		uint32_t stagedBytes;  ///< Register bytes staged, including overwritten ones.
+		uint32_t transactions; ///< Bursts sent by commits.
+		uint32_t bytes;		   ///< Register bytes sent by commits.
+	} lp5024_StageStats_t;
+
+	/**
+	 * @brief Struct for register writes collected between LP5024_Begin and LP5024_Commit.
+	 */
+	typedef struct
+	{
+		uint8_t reg[LP5024_STAGE_REG_COUNT];			  ///< Staged register values.
+		uint8_t staged[(LP5024_STAGE_REG_COUNT + 7) / 8]; ///< Registers holding a staged value.
+		lp5024_StageStats_t statistics;					  ///< Statistics counters.
+	} lp5024_Stage_t;
+
 	/**
 	 * @brief Struct for I2C handler and address pin status.
 	 */
@@ -302,8 +449,327 @@ extern "C"
 	{
 		I2C_HandleTypeDef *hi2c;
 		lp5024_A0_t a0;
+		lp5024_Shadow_t *shadow;	   ///< Optional register shadow, NULL if not used. LP5018 and LP5024 only, ignored for other parts.
+		const lp5024_Part_t *part;	   ///< Part descriptor, NULL for LP5024.
+		const lp5024_Policy_t *policy; ///< Timeout and retry policy, NULL for the LP5024_I2C_ defaults.
+		lp5024_Stage_t *stage;		   ///< Open staging scope, NULL outside of LP5024_Begin and LP5024_Commit.
 	} lp5024_Device_t;
 
+	/**
+	 * @brief Callback for observing bus traffic of all driver transfers.
+	 */
+	typedef void (*lp5024_TransferHook_t)(void *context, lp5024_Device_t *device, uint16_t length);
+
+	/**
+	 * @brief Callback acquiring or releasing exclusive access to the bus of a device.
+	 */
+	typedef void (*lp5024_LockHook_t)(void *context, lp5024_Device_t *device);
+
+	/**
+	 * @brief Struct for lock statistics.
+	 */
+	typedef struct
+	{
+		uint32_t locks;		 ///< Acquired locks.
+		uint32_t waitCycles; ///< Cycles spent acquiring locks, see LP5024_CYCLES.
+		uint32_t worstWait;	 ///< Longest acquisition [cycles].
+	} lp5024_LockStats_t;
+
+	/**
+	 * @brief Callback freeing a hung bus, e.g. clock pulses on SCL and peripheral reinit.
+	 * Returns HAL_OK once the bus is usable again.
+	 */
+	typedef uint8_t (*lp5024_RecoveryHook_t)(void *context, I2C_HandleTypeDef *hi2c);
+
+	/**
+	 * @brief Struct for bus guard statistics.
+	 */
+	typedef struct
+	{
+		uint32_t hangs;			   ///< Detected bus hangs.
+		uint32_t recoveries;	   ///< Successful recoveries.
+		uint32_t failedRecoveries; ///< Recovery attempts that did not free the bus.
+		uint32_t fastFails;		   ///< Transactions rejected while the bus was hung.
+		uint32_t restores;		   ///< Devices restored from their shadow after a recovery.
+		uint32_t lastRecovery;	   ///< Time from first failure to recovered bus of the last hang [timestamp ticks].
+		uint32_t worstRecovery;	   ///< Longest time from first failure to recovered bus [timestamp ticks].
+	} lp5024_BusGuardStats_t;
+
+	/**
+	 * @brief Struct for hang detection and recovery of one I2C unit.
+	 */
+	typedef struct
+	{
+		I2C_HandleTypeDef *hi2c;		   ///< Guarded I2C unit.
+		lp5024_RecoveryHook_t hook;		   ///< Recovery sequence.
+		void *context;					   ///< Passed to hook.
+		uint8_t threshold;				   ///< Consecutive busy or timeout results treated as hang.
+		uint32_t holdoff;				   ///< Time between recovery attempts [timestamp ticks].
+		uint8_t failures;				   ///< Consecutive busy or timeout results.
+		uint8_t hung;					   ///< Bus considered hung.
+		uint32_t failStart;				   ///< Timestamp of the first failure of the current series.
+		uint32_t lastAttempt;			   ///< Timestamp of the last recovery attempt.
+		uint32_t epoch;					   ///< Number of recoveries, compared with the device shadows.
+		lp5024_BusGuardStats_t statistics; ///< Statistics counters.
+	} lp5024_BusGuard_t;
+
+	/**
+	 * @brief Register offsets of red, green and blue, indexed by lp5024_ColorOrder_t.
+	 */
+	extern const lp5024_ChannelMap_t LP5024_ChannelMaps[6];
+	/**
+	 * @brief Part descriptors, indexed by lp5024_PartNumber_t.
+	 */
+	extern const lp5024_Part_t LP5024_Parts[6];
+
+	/**
+	 * @brief 					Converts HSB colour to RGB values.
+	 *
+	 * @param 	red				Red value.
+	 * @param 	green			Green value.
+	 * @param 	blue 			Blue value.
+	 * @param 	hue				Hue setting (0-359).
+	 * @param 	saturation		Saturation setting (0-100).
+	 * @param 	brightness 		Brightness setting (0-100).
+	 */
+	void HSVtoRGB(uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t hue, uint8_t saturation, uint8_t brightness);
+	/**
+	 * @brief 					Installs observer of the transfers on one I2C unit, replaces previous one of the unit.
+	 * Observers of different units, e.g. one scheduler per bus, are called independently.
+	 *
+	 * @param 	hi2c			Observed I2C handler, NULL for all units.
+	 * @param 	hook			Callback or NULL to remove.
+	 * @param 	context			Passed to callback.
+	 *
+	 * @retval 	uint8_t			Error code, LP5024_INPUTOUTOFRANGE if LP5024_MAX_TRANSFER_HOOKS units are observed.
+	 */
+	uint8_t LP5024_SetTransferHook(I2C_HandleTypeDef *hi2c, lp5024_TransferHook_t hook, void *context);
+	/**
+	 * @brief 					Reports a transfer to the observers of its I2C unit.
+	 *
+	 * @param   device      	Struct with I2C handler and address pin status.
+	 * @param 	length			Number of data bytes.
+	 */
+	void LP5024_NotifyTransfer(lp5024_Device_t *device, uint16_t length);
+	/**
+	 * @brief 					Installs lock hooks serialising all bus transactions and read-modify-writes.
+	 * Hooks may be an RTOS mutex per I2C unit, interrupt masking or NULL for single threaded use.
+	 * They are not called recursively. Staging within a scope takes no lock. Install before
+	 * other tasks use the driver.
+	 *
+	 * @param 	lock			Acquires exclusive access or NULL.
+	 * @param 	unlock			Releases exclusive access or NULL.
+	 * @param 	context			Passed to hooks.
+	 */
+	void LP5024_SetLockHooks(lp5024_LockHook_t lock, lp5024_LockHook_t unlock, void *context);
+	/**
+	 * @brief 					Acquires exclusive access to the bus of a device, e.g. around single attempt calls.
+	 *
+	 * @param   device      	Struct with I2C handler and address pin status.
+	 */
+	void LP5024_Lock(lp5024_Device_t *device);
+	/**
+	 * @brief 					Releases exclusive access to the bus of a device.
+	 *
+	 * @param   device      	Struct with I2C handler and address pin status.
+	 */
+	void LP5024_Unlock(lp5024_Device_t *device);
+	/**
+	 * @brief 					Copies lock statistics, exact when one lock serialises all I2C units.
+	 *
+	 * @param 	statistics		Destination of statistics.
+	 * @param 	reset			Clears counters after copying if set.
+	 */
+	void LP5024_GetLockStats(lp5024_LockStats_t *statistics, uint8_t reset);
+	/**
+	 * @brief 					Installs hang detection for an I2C unit.
+	 * Once threshold transactions in a row failed with HAL_BUSY or HAL_TIMEOUT, transactions
+	 * fail fast with HAL_BUSY and the hook is run at most once per holdoff. After a recovery
+	 * every LP5018 or LP5024 device with shadow is restored from its shadow before its next transaction.
+	 * Replacing the guard of a unit keeps its recovery count, so no device is restored again.
+	 *
+	 * @param 	guard			Guard to initialise, must stay valid.
+	 * @param 	hi2c			Guarded I2C unit.
+	 * @param 	threshold		Consecutive busy or timeout results treated as hang.
+	 * @param 	holdoff			Time between recovery attempts [timestamp ticks].
+	 * @param 	hook			Recovery sequence.
+	 * @param 	context			Passed to hook.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_AddBusGuard(lp5024_BusGuard_t *guard, I2C_HandleTypeDef *hi2c, uint8_t threshold, uint32_t holdoff, lp5024_RecoveryHook_t hook, void *context);
+	/**
+	 * @brief 					Copies statistics of a bus guard.
+	 *
+	 * @param 	guard			Bus guard.
+	 * @param 	statistics		Destination of statistics.
+	 * @param 	reset			Clears counters after copying if set.
+	 */
+	void LP5024_GetBusGuardStats(lp5024_BusGuard_t *guard, lp5024_BusGuardStats_t *statistics, uint8_t reset);
+	/**
+	 * @brief 					Reads one register, single attempt.
+	 *
+	 * @param   device      	Struct with I2C handler and address pin status.
+	 * @param 	regAdress		Register address.
+	 * @param 	data			Destination of register value.
+	 *
+	 * @retval 	uint8_t			HAL status.
+	 */
+	uint8_t LP5024_ReadI2C(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data);
+	/**
+	 * @brief 					Writes one register, single attempt.
+	 *
+	 * @param   device      	Struct with I2C handler and address pin status.
+	 * @param 	regAdress		Register address.
+	 * @param 	data			Register value.
+	 *
+	 * @retval 	uint8_t			HAL status.
+	 */
+	uint8_t LP5024_WriteI2C(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data);
+	/**
+	 * @brief 					Reads consecutive registers in auto increment mode, single attempt.
+	 *
+	 * @param   device      	Struct with I2C handler and address pin status.
+	 * @param 	regAdress		First register address.
+	 * @param 	data			Destination of register values.
+	 * @param 	length			Number of registers.
+	 *
+	 * @retval 	uint8_t			HAL status.
+	 */
+	uint8_t LP5024_ReadBurstI2C(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data, uint16_t length);
+	/**
+	 * @brief 					Writes consecutive registers in auto increment mode, single attempt.
+	 *
+	 * @param   device      	Struct with I2C handler and address pin status.
+	 * @param 	regAdress		First register address.
+	 * @param 	data			Register values.
+	 * @param 	length			Number of registers.
+	 *
+	 * @retval 	uint8_t			HAL status.
+	 */
+	uint8_t LP5024_WriteBurstI2C(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data, uint16_t length);
+	/**
+	 * @brief 					Reads consecutive registers, repeats i2c call according to the device policy.
+	 *
+	 * @param   device      	Struct with I2C handler and address pin status.
+	 * @param 	regAdress		First register address.
+	 * @param 	data			Destination of register values.
+	 * @param 	length			Number of registers.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_ReadRegisters(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data, uint16_t length);
+	/**
+	 * @brief 					Writes consecutive registers, repeats i2c call according to the device policy.
+	 *
+	 * @param   device      	Struct with I2C handler and address pin status.
+	 * @param 	regAdress		First register address.
+	 * @param 	data			Register values.
+	 * @param 	length			Number of registers.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_WriteRegisters(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data, uint16_t length);
+	/**
+	 * @brief 					Changes bits of a register, keeps the other bits.
+	 *
+	 * @param   device      	Struct with I2C handler and address pin status.
+	 * @param 	regAdress		Register address.
+	 * @param 	mask			Bits to change.
+	 * @param 	bits			New value of changed bits.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_ModifyRegister(lp5024_Device_t *device, uint8_t regAdress, uint8_t mask, uint8_t bits);
+	/**
+	 * @brief 					Opens staging scope, following writes of the device are only collected.
+	 * Reads within the scope return staged values, without bus access if all read registers are staged.
+	 *
+	 * @param   device      	Struct with I2C handler and address pin status.
+	 * @param 	stage			Buffer for staged writes.
+	 *
+	 * @retval 	uint8_t			Error code, HAL_BUSY if a scope is already open.
+	 */
+	uint8_t LP5024_Begin(lp5024_Device_t *device, lp5024_Stage_t *stage);
+	/**
+	 * @brief 					Sends staged writes in ascending register order and closes the scope.
+	 * Last write of a register wins, neighbouring registers are merged into one burst.
+	 * Unless auto increment is enabled in both the shadow and a staged configuration, registers are sent one by one.
+	 *
+	 * @param   device      	Struct with I2C handler and address pin status.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Commit(lp5024_Device_t *device);
+	/**
+	 * @brief 					Copies statistics of a staging buffer.
+	 *
+	 * @param 	stage			Staging buffer.
+	 * @param 	statistics		Destination of statistics.
+	 * @param 	reset			Clears counters after copying if set.
+	 */
+	void LP5024_GetStageStats(lp5024_Stage_t *stage, lp5024_StageStats_t *statistics, uint8_t reset);
+	/**
+	 * @brief 					Initialises shadow with register state after reset.
+	 *
+	 * @param 	shadow			Shadow to initialise.
+	 * @param 	idleMode		Power down of idle device.
+	 * @param 	idleTimeout		Time with black outputs before power down [timestamp ticks].
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_InitShadow(lp5024_Shadow_t *shadow, lp5024_IdleMode_t idleMode, uint32_t idleTimeout);
+	/**
+	 * @brief 					Reads all registers into the shadow of a device in one burst.
+	 *
+	 * @param   device      	Struct with I2C handler, address pin status and shadow.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_SyncShadow(lp5024_Device_t *device);
+	/**
+	 * @brief 					Records written registers in the shadow of a device.
+	 * Called by all write paths, only needed for transfers outside the driver.
+	 *
+	 * @param   device      	Struct with I2C handler, address pin status and shadow.
+	 * @param 	regAdress		First register address.
+	 * @param 	data			Register values.
+	 * @param 	length			Number of registers.
+	 */
+	void LP5024_UpdateShadow(lp5024_Device_t *device, uint8_t regAdress, const uint8_t *data, uint16_t length);
+	/**
+	 * @brief 					Copies register values a device shows once its open scope is committed,
+	 * the shadow with staged values on top.
+	 *
+	 * @param   device      	LP5018 or LP5024 device with register shadow.
+	 * @param 	reg				Destination of LP5024_REG_COUNT register values.
+	 */
+	void LP5024_GetPendingRegisters(lp5024_Device_t *device, uint8_t *reg);
+	/**
+	 * @brief 					Checks if all outputs of a device are dark according to its shadow.
+	 *
+	 * @param   device      	Struct with I2C handler, address pin status and shadow.
+	 *
+	 * @retval 	uint8_t			1 if no LED is lit, 0 if lit or without usable shadow.
+	 */
+	uint8_t LP5024_IsBlack(lp5024_Device_t *device);
+	/**
+	 * @brief 					Powers device down if it was black for the idle timeout, call periodically.
+	 * The next write with visible content wakes it up again.
+	 *
+	 * @param   device      	Struct with I2C handler, address pin status and shadow.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_IdleTick(lp5024_Device_t *device);
+	/**
+	 * @brief 					Restores powered down device from its shadow, in one burst with auto increment, otherwise register by register.
+	 *
+	 * @param   device      	Struct with I2C handler, address pin status and shadow.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Wake(lp5024_Device_t *device);
 	/**
 	 * @brief 					Enables/Disables Chip.
 	 *
@@ -396,6 +862,15 @@ extern "C"
 	 * @retval 	uint8_t			Error code.
 	 */
 	uint8_t LP5024_SetRGBLEDBrightness(lp5024_Device_t *device, lp5024_RGBLEDs_t rgbLED, uint8_t brightness);
+	/**
+	 * @brief 					Sets brightness of all RGB LEDs with one burst, requires auto increment.
+	 *
+	 * @param   device      	Struct with I2C handler and address pin status.
+	 * @param 	brightness		Brightness of every RGB LED, starting with RGB LED 0.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_SetAllRGBLEDBrightness(lp5024_Device_t *device, const uint8_t *brightness);
 	/**
 	 * @brief 					Sets brightness of single LED.
 	 *
@@ -443,6 +918,18 @@ extern "C"
 	 * @retval 	uint8_t			Error code.
 	 */
 	uint8_t LP5024_SetLEDColourHSB(lp5024_Device_t *device, uint8_t rgb, uint8_t rgbLED, uint16_t hue, uint8_t saturation, uint8_t brightness);
+	/**
+	 * @brief 					Sets LED colour at full brightness, intensity is left to the RGB LED brightness register.
+	 *
+	 * @param   device      	Struct with I2C handler and address pin status.
+	 * @param 	rgb				Order of colours.
+	 * @param 	rgbLED			Selected LED.
+	 * @param 	hue				Hue setting.
+	 * @param 	saturation		Saturation setting.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_SetLEDHueSaturation(lp5024_Device_t *device, uint8_t rgb, uint8_t rgbLED, uint16_t hue, uint8_t saturation);
 	/**
 	 * @brief 					Sets LED colour in RGB Format.
 	 *
@@ -456,6 +943,18 @@ extern "C"
 	 * @retval 	uint8_t			Error code.
 	 */
 	uint8_t LP5024_SetLEDColourRGB(lp5024_Device_t *device, uint8_t rgb, uint8_t rgbLED, uint8_t red, uint8_t green, uint8_t blue);
+	/**
+	 * @brief 					Sets colour of consecutive LEDs in RGB Format with one burst, requires auto increment.
+	 *
+	 * @param   device      	Struct with I2C handler and address pin status.
+	 * @param 	rgb				Order of colours.
+	 * @param 	firstLED		First selected LED.
+	 * @param 	count			Number of LEDs.
+	 * @param 	colours			Red, green and blue value of every LED.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_SetLEDColoursRGB(lp5024_Device_t *device, uint8_t rgb, uint8_t firstLED, uint8_t count, const uint8_t *colours);
 
 	/**
 	 * @}
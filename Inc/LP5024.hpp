@@ -0,0 +1,300 @@
+/**
+ ******************************************************************************
+ * @file    LP5024.hpp
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Header only C++ layer for LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Address pin status, colour order and bus backend are template parameters,
+ * so the I2C address and the colour permutation are constants and setting an
+ * LED compiles to three stores into the burst buffer. The buffer is sent as
+ * one burst to the OUTx registers on flush.
+ *
+ * Bus backends:
+ * lp5024::DriverBus	LP5024_WriteRegisters, with retry policy, staging, locks, bus guard,
+ * 					register shadow and transfer hook. Address is taken from the device struct.
+ * lp5024::BlockingBus	HAL_I2C_Mem_Write at the compile time address, without driver bookkeeping.
+ * lp5024::DmaBus		HAL_I2C_Mem_Write_DMA at the compile time address, buffer must not change until completion.
+ *
+ * Example:
+ * lp5024::Device<LP5024_A1_GND_A0_VDD, LP5024_GRB> leds(&hi2c1);
+ * leds.SetLEDColourRGB<LP5024_RGBLED_0>(255, 0, 0);
+ * leds.Flush();
+ * @endverbatim
+ ******************************************************************************
+ */
+
+/** @addtogroup IC_Drivers
+ * @{
+ */
+
+/** @addtogroup LED_Driver
+ * @{
+ */
+
+#ifndef CUSTOM_DRIVERS_INC_LP5024_HPP_
+#define CUSTOM_DRIVERS_INC_LP5024_HPP_
+
+// Includes
+#include "LP5024.h"
+
+namespace lp5024
+{
+	/**
+	 * @brief Register offsets of the colours within one RGB LED, resolved at compile time.
+	 */
+	template <lp5024_ColorOrder_t Order>
+	struct ChannelMap;
+
+	template <>
+	struct ChannelMap<LP5024_RGB>
+	{
+		static constexpr uint8_t red = 0, green = 1, blue = 2;
+	};
+	template <>
+	struct ChannelMap<LP5024_RBG>
+	{
+		static constexpr uint8_t red = 0, green = 2, blue = 1;
+	};
+	template <>
+	struct ChannelMap<LP5024_GRB>
+	{
+		static constexpr uint8_t red = 1, green = 0, blue = 2;
+	};
+	template <>
+	struct ChannelMap<LP5024_GBR>
+	{
+		static constexpr uint8_t red = 2, green = 0, blue = 1;
+	};
+	template <>
+	struct ChannelMap<LP5024_BGR>
+	{
+		static constexpr uint8_t red = 2, green = 1, blue = 0;
+	};
+	template <>
+	struct ChannelMap<LP5024_BRG>
+	{
+		static constexpr uint8_t red = 1, green = 2, blue = 0;
+	};
+
+	/**
+	 * @brief Register addresses of one RGB LED.
+	 */
+	template <lp5024_RGBLEDs_t RGBLED>
+	struct RegisterMap
+	{
+		static_assert(RGBLED < LP5024_RGBLED_COUNT, "RGB LED out of range.");
+		static constexpr uint8_t brightness = LP5024_REG_BRIGHT_RGB_0 + RGBLED; ///< RGBx_BRIGHTNESS register.
+		static constexpr uint8_t out = LP5024_REG_BRIGHT_LED_0 + (RGBLED * 3); ///< First OUTx register.
+	};
+
+	/**
+	 * @brief Bus backend using the driver's transaction core with retry policy, staging, locks and bus guard.
+	 * The core addresses the chip from the device struct, so no address is passed.
+	 */
+	struct DriverBus
+	{
+		static uint8_t Write(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data, uint16_t length)
+		{
+			return LP5024_WriteRegisters(device, regAdress, data, length);
+		}
+	};
+
+	/**
+	 * @brief Bus backend using blocking HAL transfers with the timeout of the device policy.
+	 */
+	struct BlockingBus
+	{
+		static uint8_t Write(lp5024_Device_t *device, uint16_t address, uint8_t regAdress, uint8_t *data, uint16_t length)
+		{
+			return HAL_I2C_Mem_Write(device->hi2c, address, regAdress, I2C_MEMADD_SIZE_8BIT, data, length, device->policy != nullptr ? device->policy->timeout : LP5024_I2C_TIMEOUT);
+		}
+	};
+
+	/**
+	 * @brief Bus backend using HAL DMA transfers.
+	 */
+	struct DmaBus
+	{
+		static uint8_t Write(lp5024_Device_t *device, uint16_t address, uint8_t regAdress, uint8_t *data, uint16_t length)
+		{
+			return HAL_I2C_Mem_Write_DMA(device->hi2c, address, regAdress, I2C_MEMADD_SIZE_8BIT, data, length);
+		}
+	};
+
+	/**
+	 * @brief LP5024 with compile time address and colour order.
+	 *
+	 * @tparam 	A0				Address pin status.
+	 * @tparam 	Order			Order of colours.
+	 * @tparam 	Bus				Bus backend.
+	 */
+	template <lp5024_A0_t A0, lp5024_ColorOrder_t Order = LP5024_RGB, class Bus = DriverBus>
+	class Device
+	{
+	public:
+		static constexpr uint16_t address = (LP5024_ADDRESS + A0) << 1; ///< Shifted I2C address.
+		using Map = ChannelMap<Order>;
+
+		/**
+		 * @brief 					Creates device with all LEDs off.
+		 *
+		 * @param 	hi2c			I2C handler.
+		 * @param 	shadow			Optional register shadow.
+		 */
+		explicit Device(I2C_HandleTypeDef *hi2c, lp5024_Shadow_t *shadow = nullptr) : device{hi2c, A0, shadow, nullptr, nullptr, nullptr}, frame{}
+		{
+		}
+
+		/**
+		 * @brief 					Returns device struct for use with the C API.
+		 *
+		 * @retval 	lp5024_Device_t*	Device struct.
+		 */
+		lp5024_Device_t *Handle()
+		{
+			return &device;
+		}
+
+		/**
+		 * @brief 					Returns burst buffer of the OUTx registers for direct rendering.
+		 *
+		 * @retval 	uint8_t*		Burst buffer.
+		 */
+		uint8_t *Frame()
+		{
+			return frame;
+		}
+
+		/**
+		 * @brief 					Sets colour of a compile time selected LED in RGB Format.
+		 *
+		 * @tparam 	RGBLED			Selected LED.
+		 * @param 	red				Red value.
+		 * @param 	green			Green value.
+		 * @param 	blue 			Blue value.
+		 */
+		template <lp5024_RGBLEDs_t RGBLED>
+		void SetLEDColourRGB(uint8_t red, uint8_t green, uint8_t blue)
+		{
+			constexpr uint8_t offset = RegisterMap<RGBLED>::out - LP5024_REG_BRIGHT_LED_0;
+			frame[offset + Map::red] = red;
+			frame[offset + Map::green] = green;
+			frame[offset + Map::blue] = blue;
+		}
+
+		/**
+		 * @brief 					Sets LED colour in RGB Format.
+		 *
+		 * @param 	rgbLED			Selected LED.
+		 * @param 	red				Red value.
+		 * @param 	green			Green value.
+		 * @param 	blue 			Blue value.
+		 *
+		 * @retval 	uint8_t			Error code.
+		 */
+		uint8_t SetLEDColourRGB(uint8_t rgbLED, uint8_t red, uint8_t green, uint8_t blue)
+		{
+			/* Checks for input errors. */
+			if (rgbLED >= LP5024_RGBLED_COUNT)
+			{
+				return LP5024_INPUTOUTOFRANGE;
+			}
+			uint8_t *led = &frame[rgbLED * 3];
+			led[Map::red] = red;
+			led[Map::green] = green;
+			led[Map::blue] = blue;
+			return LP5024_SUCCESS;
+		}
+
+		/**
+		 * @brief 					Sets LED colour in HSB Format.
+		 *
+		 * @param 	rgbLED			Selected LED.
+		 * @param 	hue				Hue setting (0-359).
+		 * @param 	saturation		Saturation setting (0-100).
+		 * @param 	brightness		Brightness setting (0-100).
+		 *
+		 * @retval 	uint8_t			Error code.
+		 */
+		uint8_t SetLEDColourHSB(uint8_t rgbLED, uint16_t hue, uint8_t saturation, uint8_t brightness)
+		{
+			uint8_t red, green, blue;
+			/* Checks for input errors. */
+			if (hue >= 360 || saturation > 100 || brightness > 100)
+			{
+				return LP5024_INPUTOUTOFRANGE;
+			}
+			HSVtoRGB(&red, &green, &blue, hue, saturation, brightness);
+			return SetLEDColourRGB(rgbLED, red, green, blue);
+		}
+
+		/**
+		 * @brief 					Sets all LEDs to one colour.
+		 *
+		 * @param 	red				Red value.
+		 * @param 	green			Green value.
+		 * @param 	blue 			Blue value.
+		 */
+		void FillRGB(uint8_t red, uint8_t green, uint8_t blue)
+		{
+			for (uint8_t led = 0; led < LP5024_LED_COUNT; led += 3)
+			{
+				frame[led + Map::red] = red;
+				frame[led + Map::green] = green;
+				frame[led + Map::blue] = blue;
+			}
+		}
+
+		/**
+		 * @brief 					Sends burst buffer to the OUTx registers.
+		 *
+		 * @retval 	uint8_t			Error code.
+		 */
+		uint8_t Flush()
+		{
+			return Write(LP5024_REG_BRIGHT_LED_0, frame, LP5024_LED_COUNT);
+		}
+
+		/**
+		 * @brief 					Sets brightness of all RGB LEDs in one burst.
+		 *
+		 * @param 	brightness		Brightness of RGB LED 0 to 7, must stay valid until the transfer is done.
+		 *
+		 * @retval 	uint8_t			Error code.
+		 */
+		uint8_t SetRGBLEDBrightness(uint8_t (&brightness)[LP5024_RGBLED_COUNT])
+		{
+			return Write(LP5024_REG_BRIGHT_RGB_0, brightness, LP5024_RGBLED_COUNT);
+		}
+
+	private:
+		/* Sends through a backend addressing the chip from the device struct. */
+		template <class B = Bus>
+		auto Write(uint8_t regAdress, uint8_t *data, uint16_t length) -> decltype(B::Write(static_cast<lp5024_Device_t *>(nullptr), regAdress, data, length))
+		{
+			return B::Write(&device, regAdress, data, length);
+		}
+
+		/* Sends through a backend taking the compile time address. */
+		template <class B = Bus>
+		auto Write(uint8_t regAdress, uint8_t *data, uint16_t length) -> decltype(B::Write(static_cast<lp5024_Device_t *>(nullptr), address, regAdress, data, length))
+		{
+			return B::Write(&device, address, regAdress, data, length);
+		}
+
+		lp5024_Device_t device;			 ///< Device struct shared with the C API.
+		uint8_t frame[LP5024_LED_COUNT]; ///< Burst buffer of the OUTx registers.
+	};
+} // namespace lp5024
+
+#endif /* CUSTOM_DRIVERS_INC_LP5024_HPP_ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
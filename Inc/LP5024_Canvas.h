@@ -0,0 +1,162 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Canvas.h
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Headerfile for virtual LED canvas spanning many LP5024 LED driver ICs.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * A canvas addresses RGB LEDs by logical index, e.g. the position on a
+ * strip. A map resolves every logical LED to chip handle, RGB LED and colour
+ * order, so reversed wiring and mixed colour orders are hidden from the
+ * renderer. The map may be a const table or be built at start-up with
+ * LP5024_Canvas_MapRun. It is resolved once to OUTx image offsets of the
+ * device table, setting an LED is a store and a mark.
+ *
+ * Changed chips are sent through LP5024_Table_Flush, so a full canvas
+ * update costs one burst per chip, regardless of the bus a chip sits on.
+ *
+ * RAM per LED: LP5024_CANVAS_BYTES_PER_LED (4 bytes).
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#ifndef CUSTOM_DRIVERS_INC_LP5024_CANVAS_H_
+#define CUSTOM_DRIVERS_INC_LP5024_CANVAS_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	/** @addtogroup IC_Drivers
+	 * @{
+	 */
+
+	/** @addtogroup LED_Driver
+	 * @{
+	 */
+
+// Includes
+#include "LP5024_Table.h"
+
+#ifndef LP5024_CANVAS_MAX_LEDS
+#define LP5024_CANVAS_MAX_LEDS (64) ///< Max. number of logical LEDs.
+#endif
+
+/** RAM used per logical LED. */
+#define LP5024_CANVAS_BYTES_PER_LED (sizeof(uint16_t) + 2)
+
+	/**
+	 * @brief Struct for physical position of a logical LED.
+	 */
+	typedef struct
+	{
+		lp5024_Handle_t handle; ///< Chip handle within the device table.
+		uint8_t rgbLED;			///< RGB LED of the chip.
+		uint8_t rgb;			///< Order of colours.
+	} lp5024_CanvasMap_t;
+
+	/**
+	 * @brief Struct for canvas statistics.
+	 */
+	typedef struct
+	{
+		uint32_t updates;	   ///< Calls setting LEDs.
+		uint32_t leds;		   ///< Mapped LEDs.
+		uint32_t cycles;	   ///< Cycles spent mapping, see LP5024_CYCLES.
+		uint32_t transactions; ///< Bursts sent.
+		uint32_t bytes;		   ///< Register bytes sent.
+	} lp5024_CanvasStats_t;
+
+	/**
+	 * @brief Struct for virtual canvas on top of a device table.
+	 */
+	typedef struct
+	{
+		lp5024_DeviceTable_t *table;			 ///< Table holding the chips.
+		uint16_t offset[LP5024_CANVAS_MAX_LEDS]; ///< Position of every LED within the OUTx images.
+		uint8_t handle[LP5024_CANVAS_MAX_LEDS];	 ///< Chip handle of every LED.
+		uint8_t rgb[LP5024_CANVAS_MAX_LEDS];	 ///< Order of colours of every LED.
+		uint16_t count;							 ///< Number of logical LEDs.
+		lp5024_CanvasStats_t statistics;		 ///< Statistics counters.
+	} lp5024_Canvas_t;
+
+	/**
+	 * @brief 					Fills map entries for consecutive RGB LEDs of one chip.
+	 *
+	 * @param 	map				First map entry to fill.
+	 * @param 	handle			Chip handle.
+	 * @param 	firstLED		RGB LED of the chip shown at the first entry.
+	 * @param 	count			Number of entries.
+	 * @param 	rgb				Order of colours.
+	 * @param 	reverse			RGB LEDs are wired in descending order, if set.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Canvas_MapRun(lp5024_CanvasMap_t *map, lp5024_Handle_t handle, uint8_t firstLED, uint8_t count, uint8_t rgb, uint8_t reverse);
+	/**
+	 * @brief 					Initialises canvas, resolves map against the table.
+	 *
+	 * @param 	canvas			Canvas to initialise.
+	 * @param 	table			Table holding the chips, all of them added.
+	 * @param 	map				Physical position of every logical LED.
+	 * @param 	count			Number of logical LEDs.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Canvas_Init(lp5024_Canvas_t *canvas, lp5024_DeviceTable_t *table, const lp5024_CanvasMap_t *map, uint16_t count);
+	/**
+	 * @brief 					Sets colour of a logical LED.
+	 *
+	 * @param 	canvas			Canvas handle.
+	 * @param 	index			Logical LED.
+	 * @param 	red				Red value.
+	 * @param 	green			Green value.
+	 * @param 	blue 			Blue value.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Canvas_SetLED(lp5024_Canvas_t *canvas, uint16_t index, uint8_t red, uint8_t green, uint8_t blue);
+	/**
+	 * @brief 					Sets colours of a range of logical LEDs.
+	 *
+	 * @param 	canvas			Canvas handle.
+	 * @param 	first			First logical LED.
+	 * @param 	count			Number of LEDs.
+	 * @param 	colours			Red, green and blue value of every LED.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Canvas_Write(lp5024_Canvas_t *canvas, uint16_t first, uint16_t count, const uint8_t *colours);
+	/**
+	 * @brief 					Sends all chips changed since last flush, one burst per chip.
+	 * A failing chip stays marked and does not stop the others, the first error is returned.
+	 *
+	 * @param 	canvas			Canvas handle.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Canvas_Flush(lp5024_Canvas_t *canvas);
+	/**
+	 * @brief 					Reads statistics.
+	 *
+	 * @param 	canvas			Canvas handle.
+	 * @param 	statistics		Destination of statistics.
+	 * @param 	reset			Clears counters if not zero.
+	 */
+	void LP5024_Canvas_GetStats(lp5024_Canvas_t *canvas, lp5024_CanvasStats_t *statistics, uint8_t reset);
+
+	/**
+	 * @}
+	 */
+
+	/**
+	 * @}
+	 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CUSTOM_DRIVERS_INC_LP5024_CANVAS_H_ */
@@ -0,0 +1,160 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Compositor.h
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Headerfile for layer compositor of LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * A device owns a fixed stack of layers, layer 0 at the bottom. Every layer
+ * holds a colour and an alpha (0 transparent, 255 opaque) per RGB LED, so a
+ * background animation and overlays are set independently. Blending runs
+ * bottom up on black in integer arithmetic:
+ * out = (out * (255 - alpha) + colour * alpha) / 255
+ *
+ * Only LEDs with changed layer input are blended, only LEDs with changed
+ * result are sent, as one burst from the first to the last changed LED.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#ifndef CUSTOM_DRIVERS_INC_LP5024_COMPOSITOR_H_
+#define CUSTOM_DRIVERS_INC_LP5024_COMPOSITOR_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	/** @addtogroup IC_Drivers
+	 * @{
+	 */
+
+	/** @addtogroup LED_Driver
+	 * @{
+	 */
+
+// Includes
+#include "LP5024.h"
+
+#ifndef LP5024_COMPOSITOR_LAYERS
+#define LP5024_COMPOSITOR_LAYERS (4) ///< Number of layers per device.
+#endif
+
+	/**
+	 * @brief Struct for compositor statistics.
+	 */
+	typedef struct
+	{
+		uint32_t frames;	   ///< Flushed frames.
+		uint32_t blended;	   ///< Blended LEDs.
+		uint32_t cycles;	   ///< Cycles spent blending, see LP5024_CYCLES.
+		uint32_t transactions; ///< Bursts sent.
+		uint32_t bytes;		   ///< Register bytes sent.
+	} lp5024_CompositorStats_t;
+
+	/**
+	 * @brief Struct for one layer.
+	 */
+	typedef struct
+	{
+		uint8_t colour[LP5024_RGBLED_COUNT][3];	///< Red, green and blue value of every LED.
+		uint8_t alpha[LP5024_RGBLED_COUNT];		///< Coverage of every LED, 0 transparent.
+	} lp5024_Layer_t;
+
+	/**
+	 * @brief Struct for layer compositor of one device.
+	 */
+	typedef struct
+	{
+		lp5024_Device_t *device;						 ///< Device the result is sent to.
+		const lp5024_ChannelMap_t *map;					 ///< Colour order of the device.
+		lp5024_Layer_t layers[LP5024_COMPOSITOR_LAYERS]; ///< Layer stack, layer 0 at the bottom.
+		uint8_t image[LP5024_LED_COUNT];				 ///< Blended OUTx image as sent.
+		uint32_t dirty;									 ///< LEDs with changed layer input.
+		uint32_t unsent;								 ///< LEDs with changed result, not sent yet.
+		lp5024_CompositorStats_t statistics;			 ///< Statistics counters.
+	} lp5024_Compositor_t;
+
+	/**
+	 * @brief 					Initialises compositor with transparent layers.
+	 *
+	 * @param 	compositor		Compositor to initialise.
+	 * @param   device      	Struct with I2C handler and address pin status, LP5018 or LP5024.
+	 * @param 	rgb				Order of colours.
+	 *
+	 * @retval 	uint8_t			Error code, LP5024_INPUTOUTOFRANGE for other parts.
+	 */
+	uint8_t LP5024_Compositor_Init(lp5024_Compositor_t *compositor, lp5024_Device_t *device, uint8_t rgb);
+	/**
+	 * @brief 					Sets colour and alpha of an LED within a layer.
+	 *
+	 * @param 	compositor		Compositor handle.
+	 * @param 	layer			Selected layer.
+	 * @param 	rgbLED			Selected LED.
+	 * @param 	red				Red value.
+	 * @param 	green			Green value.
+	 * @param 	blue 			Blue value.
+	 * @param 	alpha			Coverage, 0 transparent, 255 opaque.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Compositor_SetLED(lp5024_Compositor_t *compositor, uint8_t layer, uint8_t rgbLED, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha);
+	/**
+	 * @brief 					Sets alpha of an LED within a layer, keeps its colour.
+	 *
+	 * @param 	compositor		Compositor handle.
+	 * @param 	layer			Selected layer.
+	 * @param 	rgbLED			Selected LED.
+	 * @param 	alpha			Coverage, 0 transparent, 255 opaque.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Compositor_SetAlpha(lp5024_Compositor_t *compositor, uint8_t layer, uint8_t rgbLED, uint8_t alpha);
+	/**
+	 * @brief 					Makes all LEDs of a layer transparent, e.g. when an overlay ends.
+	 *
+	 * @param 	compositor		Compositor handle.
+	 * @param 	layer			Selected layer.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Compositor_ClearLayer(lp5024_Compositor_t *compositor, uint8_t layer);
+	/**
+	 * @brief 					Blends LEDs with changed input into the image, the next flush sends them.
+	 *
+	 * @param 	compositor		Compositor handle.
+	 *
+	 * @retval 	uint32_t		LEDs with changed result, bit per RGB LED.
+	 */
+	uint32_t LP5024_Compositor_Blend(lp5024_Compositor_t *compositor);
+	/**
+	 * @brief 					Blends and sends changed LEDs in one burst.
+	 *
+	 * @param 	compositor		Compositor handle.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Compositor_Flush(lp5024_Compositor_t *compositor);
+	/**
+	 * @brief 					Reads statistics.
+	 *
+	 * @param 	compositor		Compositor handle.
+	 * @param 	statistics		Destination of statistics.
+	 * @param 	reset			Clears counters if not zero.
+	 */
+	void LP5024_Compositor_GetStats(lp5024_Compositor_t *compositor, lp5024_CompositorStats_t *statistics, uint8_t reset);
+
+	/**
+	 * @}
+	 */
+
+	/**
+	 * @}
+	 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CUSTOM_DRIVERS_INC_LP5024_COMPOSITOR_H_ */
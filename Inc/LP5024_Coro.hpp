@@ -0,0 +1,449 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Coro.hpp
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Header only C++20 coroutine layer for LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Register operations are awaitables. Awaiting one queues it on the bus of
+ * the device and suspends the calling coroutine; the transfer runs via DMA.
+ * The completion interrupt only moves the operation to a done list and
+ * starts the next queued transfer. Coroutines are resumed and fades are
+ * stepped by Poll() from thread context, so a cooperative scheduler never
+ * runs task code inside an interrupt. All list changes happen with
+ * interrupts disabled.
+ *
+ * Operations live in the frame of the awaiting coroutine and are linked
+ * intrusively, so no heap is used per operation. Buffers passed to an
+ * operation must stay valid until the await returns. Writes update the
+ * register shadow like the blocking driver, staging scopes are not used.
+ *
+ * Operations:
+ * Write		Consecutive registers in one burst.
+ * Read			Consecutive registers in one burst.
+ * Flush		OUTx image of a device in one burst.
+ * Fade			RGBx brightness from one value to another over a duration,
+ * 				at most one write per timestamp tick.
+ *
+ * Example:
+ * lp5024::coro::Bus bus(&hi2c1);
+ * Task Blink(lp5024_Device_t *leds, uint8_t *frame)
+ * {
+ * 	co_await bus.Flush(leds, frame);
+ * 	co_await bus.Fade(leds, LP5024_RGBLED_0, 255, 0, 500);
+ * }
+ * void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c) { bus.TxCpltCallback(hi2c); }
+ * void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c) { bus.RxCpltCallback(hi2c); }
+ * void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) { bus.ErrorCallback(hi2c); }
+ * while (1) { bus.Poll(); Scheduler(); }
+ * @endverbatim
+ ******************************************************************************
+ */
+
+/** @addtogroup IC_Drivers
+ * @{
+ */
+
+/** @addtogroup LED_Driver
+ * @{
+ */
+
+#ifndef CUSTOM_DRIVERS_INC_LP5024_CORO_HPP_
+#define CUSTOM_DRIVERS_INC_LP5024_CORO_HPP_
+
+// Includes
+#include <coroutine>
+#include "LP5024.h"
+
+namespace lp5024
+{
+	namespace coro
+	{
+		class Bus;
+
+		/**
+		 * @brief Awaitable register operation, queued on a bus while suspended.
+		 */
+		class Operation
+		{
+		public:
+			/**
+			 * @brief Enum for kinds of operations.
+			 */
+			enum class Kind : uint8_t
+			{
+				Read,
+				Write,
+				Fade
+			};
+
+			Operation(Bus *bus, Kind kind, lp5024_Device_t *device, uint8_t regAdress, uint8_t *data, uint16_t length)
+				: bus{bus}, device{device}, data{data}, length{length}, regAdress{regAdress}, kind{kind}
+			{
+			}
+			Operation(Bus *bus, lp5024_Device_t *device, uint8_t regAdress, uint8_t from, uint8_t to, uint32_t duration)
+				: bus{bus}, device{device}, data{&value}, length{1}, regAdress{regAdress}, kind{Kind::Fade}, value{from}, from{from}, to{to}, duration{duration}
+			{
+			}
+			Operation(const Operation &) = delete;
+			Operation &operator=(const Operation &) = delete;
+
+			bool await_ready() const noexcept
+			{
+				return false;
+			}
+			bool await_suspend(std::coroutine_handle<> handle) noexcept;
+			/**
+			 * @brief 					Returns result of the operation.
+			 *
+			 * @retval 	uint8_t			Error code.
+			 */
+			uint8_t await_resume() const noexcept
+			{
+				return status;
+			}
+
+		private:
+			friend class Bus;
+
+			Operation *next = nullptr;		///< Next operation of the same list.
+			std::coroutine_handle<> waiter;	///< Suspended coroutine.
+			Bus *bus;						///< Bus running the operation.
+			lp5024_Device_t *device;		///< Target device.
+			uint8_t *data;					///< Register values.
+			uint16_t length;				///< Number of registers.
+			uint8_t regAdress;				///< First register address.
+			Kind kind;						///< Kind of operation.
+			uint8_t status = HAL_OK;		///< Result of the operation.
+			uint8_t value = 0;				///< Fade: brightness currently sent.
+			uint8_t from = 0;				///< Fade: start brightness.
+			uint8_t to = 0;					///< Fade: target brightness.
+			uint32_t start = 0;				///< Fade: timestamp of the first write.
+			uint32_t duration = 0;			///< Fade: duration [timestamp ticks].
+			uint32_t last = 0;				///< Fade: timestamp of the last write.
+		};
+
+		/**
+		 * @brief Queue of operations sharing one I2C unit.
+		 */
+		class Bus
+		{
+		public:
+			/**
+			 * @brief 					Creates idle bus.
+			 *
+			 * @param 	hi2c			I2C handler.
+			 */
+			explicit Bus(I2C_HandleTypeDef *hi2c) : hi2c{hi2c}
+			{
+			}
+			Bus(const Bus &) = delete;
+			Bus &operator=(const Bus &) = delete;
+
+			/**
+			 * @brief 					Writes consecutive registers in one burst.
+			 *
+			 * @param   device      	Struct with I2C handler and address pin status.
+			 * @param 	regAdress		First register address.
+			 * @param 	data			Register values.
+			 * @param 	length			Number of registers.
+			 *
+			 * @retval 	Operation		Awaitable returning the error code.
+			 */
+			Operation Write(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data, uint16_t length)
+			{
+				return Operation(this, Operation::Kind::Write, device, regAdress, data, length);
+			}
+			/**
+			 * @brief 					Reads consecutive registers in one burst.
+			 *
+			 * @param   device      	Struct with I2C handler and address pin status.
+			 * @param 	regAdress		First register address.
+			 * @param 	data			Destination of register values.
+			 * @param 	length			Number of registers.
+			 *
+			 * @retval 	Operation		Awaitable returning the error code.
+			 */
+			Operation Read(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data, uint16_t length)
+			{
+				return Operation(this, Operation::Kind::Read, device, regAdress, data, length);
+			}
+			/**
+			 * @brief 					Sends OUTx image of a device in one burst.
+			 *
+			 * @param   device      	Struct with I2C handler and address pin status.
+			 * @param 	frame			OUTx image, three bytes per RGB LED of the part.
+			 *
+			 * @retval 	Operation		Awaitable returning the error code.
+			 */
+			Operation Flush(lp5024_Device_t *device, uint8_t *frame)
+			{
+				return Operation(this, Operation::Kind::Write, device, LP5024_PART(device)->regLED, frame, LP5024_PART(device)->rgbLEDs * 3);
+			}
+			/**
+			 * @brief 					Fades brightness of an RGB LED linearly.
+			 *
+			 * @param   device      	Struct with I2C handler and address pin status.
+			 * @param 	rgbLED			Selected LED.
+			 * @param 	from			Start brightness.
+			 * @param 	to				Target brightness.
+			 * @param 	duration		Duration [timestamp ticks].
+			 *
+			 * @retval 	Operation		Awaitable returning the error code.
+			 */
+			Operation Fade(lp5024_Device_t *device, uint8_t rgbLED, uint8_t from, uint8_t to, uint32_t duration)
+			{
+				/* Checks for input errors, completes without bus access. */
+				if (rgbLED >= LP5024_PART(device)->rgbLEDs)
+				{
+					return Operation(this, Operation::Kind::Fade, device, 0, nullptr, 0);
+				}
+				return Operation(this, device, LP5024_PART(device)->regRGBBrightness + rgbLED, from, to, duration);
+			}
+
+			/**
+			 * @brief 					Forwards HAL memory transmit completion, call from HAL_I2C_MemTxCpltCallback.
+			 *
+			 * @param 	hi2c			I2C handler of the completed transfer.
+			 */
+			void TxCpltCallback(I2C_HandleTypeDef *hi2c)
+			{
+				Complete(hi2c, HAL_OK);
+			}
+			/**
+			 * @brief 					Forwards HAL memory receive completion, call from HAL_I2C_MemRxCpltCallback.
+			 *
+			 * @param 	hi2c			I2C handler of the completed transfer.
+			 */
+			void RxCpltCallback(I2C_HandleTypeDef *hi2c)
+			{
+				Complete(hi2c, HAL_OK);
+			}
+			/**
+			 * @brief 					Forwards HAL error, call from HAL_I2C_ErrorCallback.
+			 *
+			 * @param 	hi2c			I2C handler of the failed transfer.
+			 */
+			void ErrorCallback(I2C_HandleTypeDef *hi2c)
+			{
+				Complete(hi2c, HAL_ERROR);
+			}
+
+			/**
+			 * @brief 					Resumes coroutines of completed operations and restarts a stalled queue.
+			 * Call from thread context, e.g. once per scheduler round.
+			 *
+			 * @retval 	uint16_t		Number of resumed coroutines.
+			 */
+			uint16_t Poll()
+			{
+				uint16_t resumed = 0;
+				uint32_t primask = __get_PRIMASK();
+				__disable_irq();
+				Operation *operation = done;
+				Operation *fades = waiting;
+				done = nullptr;
+				doneTail = nullptr;
+				waiting = nullptr;
+				waitingTail = nullptr;
+				__set_PRIMASK(primask);
+				while (fades != nullptr)
+				{ /* Fades waiting for the next tick are checked again. */
+					Operation *next = fades->next;
+					Step(fades);
+					fades = next;
+				}
+				while (operation != nullptr)
+				{
+					Operation *next = operation->next;
+					operation->next = nullptr;
+					if (operation->kind == Operation::Kind::Fade && operation->status == HAL_OK && operation->value != operation->to)
+					{ /* Fade continues with the next step. */
+						Step(operation);
+					}
+					else
+					{
+						operation->waiter.resume();
+						resumed++;
+					}
+					operation = next;
+				}
+				__disable_irq();
+				if (active == nullptr)
+				{ /* Queue stalled by a busy I2C unit or waits for fades. */
+					Start();
+				}
+				__set_PRIMASK(primask);
+				return resumed;
+			}
+
+			/**
+			 * @brief 					Checks if operations are queued or running.
+			 *
+			 * @retval 	bool			True while busy.
+			 */
+			bool IsBusy() const
+			{
+				return active != nullptr || head != nullptr || done != nullptr || waiting != nullptr;
+			}
+
+		private:
+			friend class Operation;
+
+			/* Appends operation to a list. */
+			static void Append(Operation *&first, Operation *&last, Operation *operation)
+			{
+				operation->next = nullptr;
+				if (last == nullptr)
+				{
+					first = operation;
+				}
+				else
+				{
+					last->next = operation;
+				}
+				last = operation;
+			}
+
+			/* Queues operation and starts it, if the bus is idle. */
+			void Submit(Operation *operation)
+			{
+				if (operation->kind == Operation::Kind::Fade)
+				{
+					operation->start = LP5024_TIMESTAMP();
+					operation->last = operation->start;
+				}
+				uint32_t primask = __get_PRIMASK();
+				__disable_irq();
+				Append(head, tail, operation);
+				if (active == nullptr)
+				{
+					Start();
+				}
+				__set_PRIMASK(primask);
+			}
+
+			/* Calculates next fade value, queues it once the timestamp moved on. Thread context only. */
+			void Step(Operation *operation)
+			{
+				uint32_t now = LP5024_TIMESTAMP();
+				bool due = now != operation->last;
+				if (due)
+				{
+					uint32_t elapsed = now - operation->start;
+					operation->last = now;
+					if (elapsed >= operation->duration)
+					{
+						operation->value = operation->to;
+					}
+					else
+					{
+						operation->value = operation->from + (int32_t)(operation->to - operation->from) * (int32_t)elapsed / (int32_t)operation->duration;
+					}
+				}
+				uint32_t primask = __get_PRIMASK();
+				__disable_irq();
+				if (due)
+				{
+					Append(head, tail, operation);
+				}
+				else
+				{ /* At most one write per timestamp tick, Poll checks again. */
+					Append(waiting, waitingTail, operation);
+				}
+				__set_PRIMASK(primask);
+			}
+
+			/* Starts queued operations until one transfer runs, called with interrupts disabled. */
+			void Start()
+			{
+				while (active == nullptr && head != nullptr)
+				{
+					Operation *operation = head;
+					uint8_t status = HAL_OK;
+					if (operation->length == 0)
+					{ /* Checks for input errors. */
+						status = LP5024_INPUTOUTOFRANGE;
+					}
+					else if (operation->kind == Operation::Kind::Read)
+					{
+						status = HAL_I2C_Mem_Read_DMA(hi2c, LP5024_I2C_ADDRESS(operation->device), operation->regAdress, I2C_MEMADD_SIZE_8BIT, operation->data, operation->length);
+					}
+					else
+					{
+						status = HAL_I2C_Mem_Write_DMA(hi2c, LP5024_I2C_ADDRESS(operation->device), operation->regAdress, I2C_MEMADD_SIZE_8BIT, operation->data, operation->length);
+					}
+					if (status == HAL_BUSY)
+					{ /* I2C unit used by someone else, Poll retries. */
+						return;
+					}
+					head = operation->next;
+					if (head == nullptr)
+					{
+						tail = nullptr;
+					}
+					if (status == HAL_OK && operation->length > 0)
+					{
+						LP5024_NotifyTransfer(operation->device, operation->length);
+						active = operation;
+					}
+					else
+					{ /* Completes operation without transfer. */
+						operation->status = status;
+						Append(done, doneTail, operation);
+					}
+				}
+			}
+
+			/* Moves running operation to the done list and starts the next one. */
+			void Complete(I2C_HandleTypeDef *handle, uint8_t status)
+			{
+				Operation *operation = active;
+				if (handle != hi2c || operation == nullptr)
+				{ /* Ignores transfers of other drivers. */
+					return;
+				}
+				active = nullptr;
+				operation->status = status;
+				if (status == HAL_OK && operation->kind != Operation::Kind::Read)
+				{
+					LP5024_UpdateShadow(operation->device, operation->regAdress, operation->data, operation->length);
+				}
+				Append(done, doneTail, operation);
+				Start();
+			}
+
+			I2C_HandleTypeDef *hi2c;		  ///< I2C handler.
+			Operation *active = nullptr;	  ///< Running operation.
+			Operation *head = nullptr;		  ///< First queued operation.
+			Operation *tail = nullptr;		  ///< Last queued operation.
+			Operation *done = nullptr;		  ///< First completed operation.
+			Operation *doneTail = nullptr;	  ///< Last completed operation.
+			Operation *waiting = nullptr;	  ///< First fade waiting for the next tick.
+			Operation *waitingTail = nullptr; ///< Last fade waiting for the next tick.
+		};
+
+		inline bool Operation::await_suspend(std::coroutine_handle<> handle) noexcept
+		{
+			waiter = handle;
+			if (kind != Kind::Read && LP5024_SHADOW(device) != nullptr && LP5024_SHADOW(device)->asleep && LP5024_Wake(device) > HAL_OK)
+			{ /* Device could not be woken, resumes at once. */
+				status = HAL_ERROR;
+				return false;
+			}
+			bus->Submit(this);
+			return true;
+		}
+	} // namespace coro
+} // namespace lp5024
+
+#endif /* CUSTOM_DRIVERS_INC_LP5024_CORO_HPP_ */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,97 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Dither.h
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Headerfile for temporal dithering of LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Channels are held with 16 bit. Every rendered frame outputs the upper
+ * byte, the lower byte is added to an error accumulator per channel and a
+ * carry raises the output by one step. Over 256 frames the mean output
+ * matches the 16 bit value, 12 bit values repeat after 16 frames.
+ *
+ * Frames are sent via the pipeline, render at a fixed high rate:
+ * One frame = 20 + 9 * 24 = 236 bit on the bus.
+ * 100 kHz: 2.4 ms per frame, max. 423 frames/s.
+ * 400 kHz: 0.6 ms per frame, max. 1694 frames/s.
+ * 12 bit without visible flicker (16 frame cycle at >= 60 Hz) needs
+ * 960 frames/s, 57 % load of a 400 kHz bus.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#ifndef CUSTOM_DRIVERS_INC_LP5024_DITHER_H_
+#define CUSTOM_DRIVERS_INC_LP5024_DITHER_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	/** @addtogroup IC_Drivers
+	 * @{
+	 */
+
+	/** @addtogroup LED_Driver
+	 * @{
+	 */
+
+// Includes
+#include "LP5024_Pipeline.h"
+
+/** Converts a 12 bit channel value to the 16 bit scale. */
+#define LP5024_DITHER_FROM_12BIT(value) ((uint16_t)(((value) << 4) | ((value) >> 8)))
+
+	/**
+	 * @brief Struct for temporal dithering.
+	 */
+	typedef struct
+	{
+		lp5024_Pipeline_t *pipeline;	  ///< Pipeline frames are sent with.
+		uint16_t value[LP5024_LED_COUNT]; ///< Channel values in OUTx order.
+		uint8_t error[LP5024_LED_COUNT];  ///< Accumulated fraction of every channel.
+		uint32_t frames;				  ///< Rendered frames.
+	} lp5024_Dither_t;
+
+	/**
+	 * @brief 					Initialises dithering with all LEDs off.
+	 *
+	 * @param 	dither			Dithering to initialise.
+	 * @param 	pipeline		Initialised pipeline.
+	 */
+	void LP5024_Dither_Init(lp5024_Dither_t *dither, lp5024_Pipeline_t *pipeline);
+	/**
+	 * @brief 					Sets LED colour with 16 bit per channel.
+	 *
+	 * @param 	dither			Dithering handle.
+	 * @param 	rgbLED			Selected LED.
+	 * @param 	red				Red value.
+	 * @param 	green			Green value.
+	 * @param 	blue 			Blue value.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Dither_SetLEDColourRGB(lp5024_Dither_t *dither, uint8_t rgbLED, uint16_t red, uint16_t green, uint16_t blue);
+	/**
+	 * @brief 					Renders next dithered frame into the pipeline and submits it, call at the frame rate.
+	 *
+	 * @param 	dither			Dithering handle.
+	 *
+	 * @retval 	uint8_t			Error code, HAL_BUSY if the pipeline can not take a frame yet.
+	 */
+	uint8_t LP5024_Dither_Render(lp5024_Dither_t *dither);
+
+	/**
+	 * @}
+	 */
+
+	/**
+	 * @}
+	 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CUSTOM_DRIVERS_INC_LP5024_DITHER_H_ */
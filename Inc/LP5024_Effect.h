@@ -0,0 +1,181 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Effect.h
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Headerfile for procedural effects of LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Effects are driven by a 32 bit phase accumulator, one full turn per
+ * period. Every tick advances the phase by the time elapsed since the last
+ * tick and renders all LEDs of a range into an OUTx register image, e.g. a
+ * table frame or a pipeline frame. Waveforms come from an integer quarter
+ * sine table and a triangle, no floats and no dynamic memory are used.
+ *
+ * Breathe	Colour scaled by sine or triangle, optionally shifted per LED.
+ * Chase	Head running along the range with a linearly fading tail.
+ * Sparkle	Random LEDs light up from a 16 bit LFSR and decay every tick.
+ * Strobe	All LEDs on for a fraction of the period.
+ *
+ * Sparkle decays the values already in the image, so its image must not be
+ * overwritten between ticks.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#ifndef CUSTOM_DRIVERS_INC_LP5024_EFFECT_H_
+#define CUSTOM_DRIVERS_INC_LP5024_EFFECT_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	/** @addtogroup IC_Drivers
+	 * @{
+	 */
+
+	/** @addtogroup LED_Driver
+	 * @{
+	 */
+
+// Includes
+#include "LP5024.h"
+
+	/**
+	 * @brief Enum for effects.
+	 */
+	typedef enum
+	{
+		LP5024_EffectBreathe,
+		LP5024_EffectChase,
+		LP5024_EffectSparkle,
+		LP5024_EffectStrobe
+	} lp5024_EffectType_t;
+
+	/**
+	 * @brief Enum for waveforms.
+	 */
+	typedef enum
+	{
+		LP5024_WaveSine,
+		LP5024_WaveTriangle
+	} lp5024_Wave_t;
+
+	/**
+	 * @brief Struct for effect statistics.
+	 */
+	typedef struct
+	{
+		uint32_t ticks;	 ///< Rendered ticks.
+		uint32_t leds;	 ///< Rendered RGB LEDs.
+		uint32_t cycles; ///< Cycles spent rendering, divide by leds for the cost per LED.
+	} lp5024_EffectStats_t;
+
+	/**
+	 * @brief Struct for one running effect.
+	 */
+	typedef struct
+	{
+		uint8_t type;					 ///< Effect, see lp5024_EffectType_t.
+		uint8_t colour[3];				 ///< Red, green and blue value at full level.
+		uint8_t wave;					 ///< Breathe waveform, see lp5024_Wave_t.
+		uint8_t spread;					 ///< Breathe phase shift between neighbouring LEDs [1/256 turn].
+		uint8_t width;					 ///< Chase length of head and tail [LEDs].
+		uint8_t duty;					 ///< Strobe on time [1/256 period].
+		uint8_t density;				 ///< Sparkle probability per LED and tick [1/256].
+		uint8_t decay;					 ///< Sparkle loss per tick [1/256].
+		uint16_t lfsr;					 ///< Sparkle random generator state.
+		uint32_t phase;					 ///< Phase accumulator, 2^32 is one period.
+		uint32_t increment;				 ///< Phase advance per timestamp tick.
+		uint32_t last;					 ///< Timestamp of last tick.
+		lp5024_EffectStats_t statistics; ///< Statistics counters.
+	} lp5024_Effect_t;
+
+	/**
+	 * @brief 					Initialises breathing effect.
+	 *
+	 * @param 	effect			Effect to initialise.
+	 * @param 	red				Red value at full level.
+	 * @param 	green			Green value at full level.
+	 * @param 	blue 			Blue value at full level.
+	 * @param 	period			Duration of one breath [timestamp ticks].
+	 * @param 	wave			Waveform.
+	 * @param 	spread			Phase shift between neighbouring LEDs, 0 for all LEDs in step.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Effect_InitBreathe(lp5024_Effect_t *effect, uint8_t red, uint8_t green, uint8_t blue, uint32_t period, lp5024_Wave_t wave, uint8_t spread);
+	/**
+	 * @brief 					Initialises chase effect.
+	 *
+	 * @param 	effect			Effect to initialise.
+	 * @param 	red				Red value of the head.
+	 * @param 	green			Green value of the head.
+	 * @param 	blue 			Blue value of the head.
+	 * @param 	period			Duration of one run along the range [timestamp ticks].
+	 * @param 	width			Length of head and tail [LEDs].
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Effect_InitChase(lp5024_Effect_t *effect, uint8_t red, uint8_t green, uint8_t blue, uint32_t period, uint8_t width);
+	/**
+	 * @brief 					Initialises sparkle effect.
+	 *
+	 * @param 	effect			Effect to initialise.
+	 * @param 	red				Red value of a new sparkle.
+	 * @param 	green			Green value of a new sparkle.
+	 * @param 	blue 			Blue value of a new sparkle.
+	 * @param 	density			Probability per LED and tick [1/256].
+	 * @param 	decay			Loss per tick [1/256].
+	 * @param 	seed			Start value of the random generator, not zero.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Effect_InitSparkle(lp5024_Effect_t *effect, uint8_t red, uint8_t green, uint8_t blue, uint8_t density, uint8_t decay, uint16_t seed);
+	/**
+	 * @brief 					Initialises strobe effect.
+	 *
+	 * @param 	effect			Effect to initialise.
+	 * @param 	red				Red value while on.
+	 * @param 	green			Green value while on.
+	 * @param 	blue 			Blue value while on.
+	 * @param 	period			Duration of one flash and pause [timestamp ticks].
+	 * @param 	duty			On time [1/256 period].
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Effect_InitStrobe(lp5024_Effect_t *effect, uint8_t red, uint8_t green, uint8_t blue, uint32_t period, uint8_t duty);
+	/**
+	 * @brief 					Advances effect to the current timestamp and renders a range of LEDs, call periodically.
+	 *
+	 * @param 	effect			Effect handle.
+	 * @param 	image			OUTx register image of the first LED.
+	 * @param 	count			Number of RGB LEDs.
+	 * @param 	rgb				Order of colours.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Effect_Tick(lp5024_Effect_t *effect, uint8_t *image, uint16_t count, uint8_t rgb);
+	/**
+	 * @brief 					Reads statistics.
+	 *
+	 * @param 	effect			Effect handle.
+	 * @param 	statistics		Destination of statistics.
+	 * @param 	reset			Clears counters if not zero.
+	 */
+	void LP5024_Effect_GetStats(lp5024_Effect_t *effect, lp5024_EffectStats_t *statistics, uint8_t reset);
+
+	/**
+	 * @}
+	 */
+
+	/**
+	 * @}
+	 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CUSTOM_DRIVERS_INC_LP5024_EFFECT_H_ */
@@ -0,0 +1,85 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Gradient.h
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Headerfile for gradient rendering of LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Gradients are rendered into register images of the OUTx registers, every
+ * LED is stepped from its neighbour with integer arithmetic, no float HSB
+ * conversion is done. Images of several chips may follow each other, e.g.
+ * the frames of a device table, so a ring across chips is rendered in one
+ * pass. Send the image with one burst per chip, see LP5024_Pipeline_GetFrame,
+ * LP5024_Table_GetFrame or LP5024_WriteRegisters.
+ *
+ * Hue is given in degrees (0-359), saturation and brightness from 0 to 100,
+ * like the HSB setters of the driver. Internally the hue circle has
+ * LP5024_GRADIENT_HUE_STEPS, so neighbouring LEDs may differ by less than
+ * a degree.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#ifndef CUSTOM_DRIVERS_INC_LP5024_GRADIENT_H_
+#define CUSTOM_DRIVERS_INC_LP5024_GRADIENT_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	/** @addtogroup IC_Drivers
+	 * @{
+	 */
+
+	/** @addtogroup LED_Driver
+	 * @{
+	 */
+
+// Includes
+#include "LP5024.h"
+
+#define LP5024_GRADIENT_HUE_STEPS (1536) ///< Internal hue steps per circle, 256 per colour sector.
+
+	/**
+	 * @brief 					Renders hue sweep, rotate it by changing the start hue every frame.
+	 *
+	 * @param 	frame			Register image of the first LED.
+	 * @param 	map				Channel map of the colour order.
+	 * @param 	count			Number of RGB LEDs.
+	 * @param 	hue				Hue of first LED (0-359).
+	 * @param 	span			Hue range across all LEDs [degrees], 360 for a full circle.
+	 * @param 	saturation		Saturation of all LEDs (0-100).
+	 * @param 	brightness		Brightness of all LEDs (0-100).
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Gradient_Rainbow(uint8_t *frame, const lp5024_ChannelMap_t *map, uint16_t count, uint16_t hue, uint16_t span, uint8_t saturation, uint8_t brightness);
+	/**
+	 * @brief 					Renders linear gradient through colour stops at equal distances.
+	 *
+	 * @param 	frame			Register image of the first LED.
+	 * @param 	map				Channel map of the colour order.
+	 * @param 	count			Number of RGB LEDs.
+	 * @param 	offset			Rotation of the gradient in LEDs, wraps around.
+	 * @param 	stops			Red, green and blue value of every stop.
+	 * @param 	stopCount		Number of stops, at least 2.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Gradient_Linear(uint8_t *frame, const lp5024_ChannelMap_t *map, uint16_t count, uint16_t offset, const uint8_t *stops, uint8_t stopCount);
+
+	/**
+	 * @}
+	 */
+
+	/**
+	 * @}
+	 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CUSTOM_DRIVERS_INC_LP5024_GRADIENT_H_ */
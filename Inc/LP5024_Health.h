@@ -0,0 +1,116 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Health.h
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Headerfile for state verification of LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * The register file 0x00 to 0x26 is read back in one burst and compared with
+ * the register shadow of the device. Only diverging spans are written again,
+ * spans separated by a short gap are repaired in one burst, since a new
+ * transaction costs more than resending the gap. With auto increment cleared
+ * in the shadow, registers are read and repaired one by one.
+ *
+ * Checks use a bus budget: every tick grants budget percent of the elapsed
+ * time as bus time, a check runs when the granted time covers the read and
+ * the I2C unit is idle. Repairs are paid from the same budget.
+ *
+ * Requires an LP5018 or LP5024 device with register shadow, see LP5024_InitShadow.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#ifndef CUSTOM_DRIVERS_INC_LP5024_HEALTH_H_
+#define CUSTOM_DRIVERS_INC_LP5024_HEALTH_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	/** @addtogroup IC_Drivers
+	 * @{
+	 */
+
+	/** @addtogroup LED_Driver
+	 * @{
+	 */
+
+// Includes
+#include "LP5024.h"
+
+/** Bits per write transaction besides data: start, address, register, stop. */
+#define LP5024_HEALTH_WRITE_OVERHEAD_BITS (20)
+/** Bits per read transaction besides data: additional repeated start and address. */
+#define LP5024_HEALTH_READ_OVERHEAD_BITS (30)
+/** Largest gap between diverging registers that is resent instead of starting a new burst. */
+#define LP5024_HEALTH_MERGE_GAP (2)
+
+	/**
+	 * @brief Struct for health check statistics.
+	 */
+	typedef struct
+	{
+		uint32_t checks;	 ///< Completed read backs.
+		uint32_t mismatches; ///< Registers found diverging.
+		uint32_t repairs;	 ///< Repair bursts sent.
+		uint32_t failures;	 ///< Failed read backs or repairs.
+		uint32_t lastCost;	 ///< Bus time of the last check including repairs [us].
+		uint32_t totalCost;	 ///< Bus time of all checks [us].
+	} lp5024_HealthStats_t;
+
+	/**
+	 * @brief Struct for health check.
+	 */
+	typedef struct
+	{
+		lp5024_Device_t *device;		 ///< Checked device.
+		uint32_t busSpeed;				 ///< I2C clock [Hz].
+		uint8_t budget;					 ///< Share of bus time granted [%].
+		int32_t credit;					 ///< Granted bus time not used yet [us].
+		uint32_t lastTick;				 ///< Timestamp of last grant.
+		lp5024_HealthStats_t statistics; ///< Statistics counters.
+	} lp5024_Health_t;
+
+	/**
+	 * @brief 					Initialises health check of a device.
+	 *
+	 * @param 	health			Health check to initialise.
+	 * @param 	device			LP5018 or LP5024 device with register shadow.
+	 * @param 	busSpeed		I2C clock [Hz].
+	 * @param 	budget			Share of bus time granted to checks [%].
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Health_Init(lp5024_Health_t *health, lp5024_Device_t *device, uint32_t busSpeed, uint8_t budget);
+	/**
+	 * @brief 					Checks and repairs device if budget allows and the bus is idle, call periodically.
+	 *
+	 * @param 	health			Health check handle.
+	 *
+	 * @retval 	uint8_t			Error code, HAL_BUSY if no check was due.
+	 */
+	uint8_t LP5024_Health_Tick(lp5024_Health_t *health);
+	/**
+	 * @brief 					Reads statistics.
+	 *
+	 * @param 	health			Health check handle.
+	 * @param 	statistics		Destination of statistics.
+	 * @param 	reset			Clears counters if not zero.
+	 */
+	void LP5024_Health_GetStats(lp5024_Health_t *health, lp5024_HealthStats_t *statistics, uint8_t reset);
+
+	/**
+	 * @}
+	 */
+
+	/**
+	 * @}
+	 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CUSTOM_DRIVERS_INC_LP5024_HEALTH_H_ */
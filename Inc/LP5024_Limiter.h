@@ -0,0 +1,140 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Limiter.h
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Headerfile for supply current limiter of many LP5024 LED driver ICs.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Once per frame the output current of all chips is estimated from their
+ * register shadows, with values staged in an open scope on top: max. current setting times PWM duty of every output, the
+ * duty being OUTx times RGBx brightness, or bank colour times bank brightness
+ * for LEDs in bank mode. Disabled chips and global LED off count as dark.
+ * In log scale the linear duty is used, which is never below the log duty.
+ *
+ * If the estimate exceeds the budget, brightness is scaled by budget/estimate:
+ * chips with all LEDs in bank mode only get the bank brightness register,
+ * others the eight RGBx brightness registers in one burst, mixed chips both.
+ * Brightness written by the application is kept as request and scaled again
+ * every frame, so limiting never compounds. Work per frame is constant per chip.
+ *
+ * Render a frame inside LP5024_Begin and LP5024_Commit and call
+ * LP5024_Limiter_Apply before the commit: the frame is limited before it is
+ * shown and the scaled brightness is sent with it. Frames written directly or
+ * through the pipeline only reach the shadow once they are sent, so they are
+ * shown unlimited for one frame.
+ *
+ * Requires LP5018 or LP5024 devices with register shadow, see LP5024_InitShadow.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#ifndef CUSTOM_DRIVERS_INC_LP5024_LIMITER_H_
+#define CUSTOM_DRIVERS_INC_LP5024_LIMITER_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	/** @addtogroup IC_Drivers
+	 * @{
+	 */
+
+	/** @addtogroup LED_Driver
+	 * @{
+	 */
+
+// Includes
+#include "LP5024.h"
+
+#ifndef LP5024_LIMITER_MAX_DEVICES
+#define LP5024_LIMITER_MAX_DEVICES (8) ///< Max. number of chips sharing one supply.
+#endif
+
+#define LP5024_LIMITER_CURRENT_26MA (25500)	///< Full scale current of max. current option 0 [uA].
+#define LP5024_LIMITER_CURRENT_35MA (35000)	///< Full scale current of max. current option 1 [uA].
+
+	/**
+	 * @brief Struct for limiter statistics.
+	 */
+	typedef struct
+	{
+		uint32_t frames;   ///< Applied frames.
+		uint32_t limited;  ///< Frames scaled down.
+		uint32_t writes;   ///< Brightness transactions sent.
+		uint32_t failures; ///< Failed brightness transactions.
+		uint32_t estimate; ///< Unlimited current of the last frame [uA].
+		uint32_t current;  ///< Limited current of the last frame [uA].
+		uint32_t peak;	   ///< Highest unlimited current [uA].
+	} lp5024_LimiterStats_t;
+
+	/**
+	 * @brief Struct for supply current limiter.
+	 */
+	typedef struct
+	{
+		lp5024_Device_t *devices[LP5024_LIMITER_MAX_DEVICES];					///< Chips sharing the supply.
+		uint8_t requested[LP5024_LIMITER_MAX_DEVICES][LP5024_RGBLED_COUNT + 1];	///< Brightness set by the application, RGBx then bank.
+		uint8_t applied[LP5024_LIMITER_MAX_DEVICES][LP5024_RGBLED_COUNT + 1];	///< Brightness written by the limiter, RGBx then bank.
+		uint8_t count;															///< Number of chips.
+		uint32_t budget;														///< Max. output current of all chips [uA].
+		lp5024_LimiterStats_t statistics;										///< Statistics counters.
+	} lp5024_Limiter_t;
+
+	/**
+	 * @brief 					Initialises limiter without chips.
+	 *
+	 * @param 	limiter			Limiter to initialise.
+	 * @param 	budget			Max. output current of all chips [uA].
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Limiter_Init(lp5024_Limiter_t *limiter, uint32_t budget);
+	/**
+	 * @brief 					Adds chip, its current brightness becomes the request.
+	 *
+	 * @param 	limiter			Limiter handle.
+	 * @param 	device			LP5018 or LP5024 device with register shadow.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Limiter_Add(lp5024_Limiter_t *limiter, lp5024_Device_t *device);
+	/**
+	 * @brief 					Estimates output current of a chip from its shadow and open scope.
+	 *
+	 * @param   device      	LP5018 or LP5024 device with register shadow.
+	 *
+	 * @retval 	uint32_t		Output current [uA], 0 without usable shadow.
+	 */
+	uint32_t LP5024_Limiter_Estimate(lp5024_Device_t *device);
+	/**
+	 * @brief 					Scales brightness of all chips to stay within the budget, call once per frame.
+	 *
+	 * @param 	limiter			Limiter handle.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Limiter_Apply(lp5024_Limiter_t *limiter);
+	/**
+	 * @brief 					Reads statistics.
+	 *
+	 * @param 	limiter			Limiter handle.
+	 * @param 	statistics		Destination of statistics.
+	 * @param 	reset			Clears counters if not zero.
+	 */
+	void LP5024_Limiter_GetStats(lp5024_Limiter_t *limiter, lp5024_LimiterStats_t *statistics, uint8_t reset);
+
+	/**
+	 * @}
+	 */
+
+	/**
+	 * @}
+	 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CUSTOM_DRIVERS_INC_LP5024_LIMITER_H_ */
@@ -0,0 +1,132 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_MultiBus.h
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Headerfile for parallel frame flush of LP5024 on several I2C units.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Pipelines are grouped by I2C handler into lanes. A flush starts the first
+ * device of every lane at once, each completion starts the next device on
+ * the same bus. Total frame time is that of the slowest bus instead of the
+ * sum of all devices.
+ *
+ * Forward the HAL callbacks to the coordinator instead of the pipelines:
+ * void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+ * {
+ * 	LP5024_MultiBus_TxCpltCallback(&multiBus, hi2c);
+ * }
+ * void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+ * {
+ * 	LP5024_MultiBus_ErrorCallback(&multiBus, hi2c);
+ * }
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#ifndef CUSTOM_DRIVERS_INC_LP5024_MULTIBUS_H_
+#define CUSTOM_DRIVERS_INC_LP5024_MULTIBUS_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	/** @addtogroup IC_Drivers
+	 * @{
+	 */
+
+	/** @addtogroup LED_Driver
+	 * @{
+	 */
+
+// Includes
+#include "LP5024_Pipeline.h"
+
+#ifndef LP5024_MULTIBUS_MAX_BUSES
+#define LP5024_MULTIBUS_MAX_BUSES (3) ///< Max. number of I2C units.
+#endif
+#ifndef LP5024_MULTIBUS_MAX_DEVICES
+#define LP5024_MULTIBUS_MAX_DEVICES (16) ///< Max. number of devices on all buses.
+#endif
+
+	/**
+	 * @brief Struct for devices sharing one I2C unit.
+	 */
+	typedef struct
+	{
+		I2C_HandleTypeDef *hi2c; ///< I2C handler of the bus.
+		uint8_t first;			 ///< Index of first pipeline of the lane.
+		uint8_t count;			 ///< Number of pipelines on the bus.
+		volatile uint8_t next;	 ///< Position of pipeline currently on the bus.
+		volatile uint32_t ticks; ///< Duration of last flush on this bus.
+	} lp5024_BusLane_t;
+
+	/**
+	 * @brief Struct for flush coordinator.
+	 */
+	typedef struct
+	{
+		lp5024_Pipeline_t *pipelines[LP5024_MULTIBUS_MAX_DEVICES]; ///< Pipelines sorted by bus.
+		lp5024_BusLane_t lanes[LP5024_MULTIBUS_MAX_BUSES];		   ///< Pipelines grouped by bus.
+		uint8_t laneCount;										   ///< Number of used lanes.
+		volatile uint8_t active;								   ///< Lanes still transmitting.
+		volatile uint32_t errors;								   ///< Failed transfers.
+		uint32_t flushStart;									   ///< Timestamp of last flush.
+		volatile uint32_t flushTicks;							   ///< Duration of last complete flush.
+	} lp5024_MultiBus_t;
+
+	/**
+	 * @brief 					Groups pipelines by their I2C handler.
+	 *
+	 * @param 	multiBus		Coordinator to initialise.
+	 * @param 	pipelines		Initialised pipelines of all devices.
+	 * @param 	count			Number of pipelines.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_MultiBus_Init(lp5024_MultiBus_t *multiBus, lp5024_Pipeline_t **pipelines, uint8_t count);
+	/**
+	 * @brief 					Starts transfer of the rendered frames of all devices.
+	 *
+	 * @param 	multiBus		Coordinator handle.
+	 *
+	 * @retval 	uint8_t			Error code, HAL_BUSY if last flush is still running.
+	 */
+	uint8_t LP5024_MultiBus_Flush(lp5024_MultiBus_t *multiBus);
+	/**
+	 * @brief 					Checks for completion of the last flush.
+	 *
+	 * @param 	multiBus		Coordinator handle.
+	 *
+	 * @retval 	uint8_t			1 if all buses are idle.
+	 */
+	uint8_t LP5024_MultiBus_IsDone(lp5024_MultiBus_t *multiBus);
+	/**
+	 * @brief 					Handles transfer completion, call from HAL_I2C_MemTxCpltCallback.
+	 *
+	 * @param 	multiBus		Coordinator handle.
+	 * @param 	hi2c			I2C handler of completed transfer.
+	 */
+	void LP5024_MultiBus_TxCpltCallback(lp5024_MultiBus_t *multiBus, I2C_HandleTypeDef *hi2c);
+	/**
+	 * @brief 					Handles transfer errors, call from HAL_I2C_ErrorCallback.
+	 *
+	 * @param 	multiBus		Coordinator handle.
+	 * @param 	hi2c			I2C handler of failed transfer.
+	 */
+	void LP5024_MultiBus_ErrorCallback(lp5024_MultiBus_t *multiBus, I2C_HandleTypeDef *hi2c);
+
+	/**
+	 * @}
+	 */
+
+	/**
+	 * @}
+	 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CUSTOM_DRIVERS_INC_LP5024_MULTIBUS_H_ */
@@ -0,0 +1,147 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Palette.h
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Headerfile for palette indexed framebuffer of many LP5024 LED driver ICs.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Every RGB LED stores a palette index of LP5024_PALETTE_BITS instead of its
+ * three OUTx values. Register images are expanded only while flushing, one
+ * chip at a time into a 24 byte image on the stack. Chips may share
+ * one palette or use their own. Changing a palette entry marks every chip
+ * using it, so the next flush recolours all of them.
+ *
+ * RAM per chip: LP5024_PALETTE_BYTES_PER_DEVICE
+ * (14 bytes with 4 bit and 18 bytes with 8 bit indices and 4 byte pointers),
+ * plus 3 bytes per palette entry per palette.
+ * Expansion cost per chip is counted via LP5024_CYCLES().
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#ifndef CUSTOM_DRIVERS_INC_LP5024_PALETTE_H_
+#define CUSTOM_DRIVERS_INC_LP5024_PALETTE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	/** @addtogroup IC_Drivers
+	 * @{
+	 */
+
+	/** @addtogroup LED_Driver
+	 * @{
+	 */
+
+// Includes
+#include "LP5024.h"
+
+#ifndef LP5024_PALETTE_BITS
+#define LP5024_PALETTE_BITS (4)	///< Bits per palette index, 4 or 8.
+#endif
+#ifndef LP5024_PALETTE_MAX_DEVICES
+#define LP5024_PALETTE_MAX_DEVICES (16)	///< Max. number of chips, up to 255.
+#endif
+
+#if LP5024_PALETTE_BITS != 4 && LP5024_PALETTE_BITS != 8
+#error "LP5024_PALETTE_BITS must be 4 or 8"
+#endif
+
+#define LP5024_PALETTE_SIZE (1 << LP5024_PALETTE_BITS)								 ///< Number of palette entries.
+#define LP5024_PALETTE_INDEX_BYTES ((LP5024_RGBLED_COUNT * LP5024_PALETTE_BITS) / 8) ///< Index bytes per chip.
+
+/** RAM used per chip. */
+#define LP5024_PALETTE_BYTES_PER_DEVICE (sizeof(I2C_HandleTypeDef *) + sizeof(void *) + 2 + LP5024_PALETTE_INDEX_BYTES)
+
+	/**
+	 * @brief Struct for colours of a palette.
+	 */
+	typedef struct
+	{
+		uint8_t colour[LP5024_PALETTE_SIZE][3];	///< Red, green and blue value of every entry.
+	} lp5024_Palette_t;
+
+	/**
+	 * @brief Struct for palette indexed framebuffer of many chips.
+	 */
+	typedef struct
+	{
+		uint8_t index[LP5024_PALETTE_MAX_DEVICES][LP5024_PALETTE_INDEX_BYTES]; ///< Palette indices of all LEDs.
+		const lp5024_Palette_t *palette[LP5024_PALETTE_MAX_DEVICES];		   ///< Palette of every chip.
+		I2C_HandleTypeDef *hi2c[LP5024_PALETTE_MAX_DEVICES];				   ///< I2C handlers.
+		uint8_t a0[LP5024_PALETTE_MAX_DEVICES];								   ///< Address pin status.
+		uint8_t rgb[LP5024_PALETTE_MAX_DEVICES];							   ///< Colour order of every chip.
+		uint32_t dirty[(LP5024_PALETTE_MAX_DEVICES + 31) / 32];				   ///< Chips with changed image.
+		uint8_t count;														   ///< Number of chips.
+		uint32_t expanded;													   ///< Expanded chips.
+		uint32_t cycles;													   ///< Cycles spent expanding, divide by expanded for the cost per chip.
+	} lp5024_PaletteBuffer_t;
+
+	/**
+	 * @brief 					Initialises empty framebuffer.
+	 *
+	 * @param 	buffer			Framebuffer to initialise.
+	 */
+	void LP5024_Palette_Init(lp5024_PaletteBuffer_t *buffer);
+	/**
+	 * @brief 					Adds chip with all LEDs at palette entry 0.
+	 *
+	 * @param 	buffer			Framebuffer handle.
+	 * @param 	hi2c			I2C handler.
+	 * @param 	a0				Address pin status.
+	 * @param 	rgb				Order of colours.
+	 * @param 	palette			Palette of the chip, may be shared with other chips.
+	 * @param 	handle			Destination of chip handle.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Palette_Add(lp5024_PaletteBuffer_t *buffer, I2C_HandleTypeDef *hi2c, lp5024_A0_t a0, uint8_t rgb, const lp5024_Palette_t *palette, uint8_t *handle);
+	/**
+	 * @brief 					Sets palette index of an LED.
+	 *
+	 * @param 	buffer			Framebuffer handle.
+	 * @param 	handle			Chip handle.
+	 * @param 	rgbLED			Selected LED.
+	 * @param 	entry			Palette index.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Palette_SetLED(lp5024_PaletteBuffer_t *buffer, uint8_t handle, uint8_t rgbLED, uint8_t entry);
+	/**
+	 * @brief 					Changes palette entry and marks all chips showing it.
+	 *
+	 * @param 	buffer			Framebuffer handle.
+	 * @param 	palette			Changed palette.
+	 * @param 	entry			Palette index.
+	 * @param 	red				Red value.
+	 * @param 	green			Green value.
+	 * @param 	blue 			Blue value.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Palette_SetEntry(lp5024_PaletteBuffer_t *buffer, lp5024_Palette_t *palette, uint8_t entry, uint8_t red, uint8_t green, uint8_t blue);
+	/**
+	 * @brief 					Expands and sends changed chips, one burst per chip.
+	 *
+	 * @param 	buffer			Framebuffer handle.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Palette_Flush(lp5024_PaletteBuffer_t *buffer);
+
+	/**
+	 * @}
+	 */
+
+	/**
+	 * @}
+	 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CUSTOM_DRIVERS_INC_LP5024_PALETTE_H_ */
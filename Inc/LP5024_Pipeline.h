@@ -0,0 +1,273 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Pipeline.h
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Headerfile for pipelined frame output of LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Two register images of the OUTx registers are owned by the pipeline.
+ * The application renders into the back buffer while the front buffer is
+ * sent via DMA/interrupt. Buffers are swapped on transfer completion.
+ *
+ * Rendering writes directly into the transmit buffer, see
+ * LP5024_Pipeline_GetLED(), so no copy is made between render and DMA.
+ *
+ * Urgent single register writes, see LP5024_Pipeline_WriteUrgent(), are sent
+ * at the next transaction boundary ahead of frames. Frames are split into
+ * chunks of LP5024_PIPELINE_CHUNK_SIZE bytes to bound the wait, the frame on
+ * the bus continues from its buffer afterwards, so it is never mixed with a
+ * newer render.
+ *
+ * A chip powered down by LP5024_IdleTick() is woken at the next transaction
+ * boundary before visible content reaches it, with transactions of its own
+ * from a copy of the shadow, like LP5024_Wake(). No call blocks, so frames
+ * may be submitted from interrupt context.
+ *
+ * Requires auto increment mode (default after reset) and forwarding of the
+ * HAL callbacks (HAL_I2C_MasterTxCpltCallback for the transmit backend):
+ * void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+ * {
+ * 	LP5024_Pipeline_TxCpltCallback(&pipeline, hi2c);
+ * }
+ * void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+ * {
+ * 	LP5024_Pipeline_ErrorCallback(&pipeline, hi2c);
+ * }
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#ifndef CUSTOM_DRIVERS_INC_LP5024_PIPELINE_H_
+#define CUSTOM_DRIVERS_INC_LP5024_PIPELINE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	/** @addtogroup IC_Drivers
+	 * @{
+	 */
+
+	/** @addtogroup LED_Driver
+	 * @{
+	 */
+
+// Includes
+#include "LP5024.h"
+
+#ifndef LP5024_PIPELINE_USE_DMA
+#define LP5024_PIPELINE_USE_DMA (1)	///< Transfer mode, 1 = DMA, 0 = interrupt.
+#endif
+#ifndef LP5024_PIPELINE_USE_TRANSMIT
+/**
+ * Bus backend, 1 = HAL_I2C_Master_Transmit with register address stored in
+ * front of the frame, 0 = HAL_I2C_Mem_Write with separate register address.
+ */
+#define LP5024_PIPELINE_USE_TRANSMIT (0)
+#endif
+#define LP5024_PIPELINE_HEADER (LP5024_PIPELINE_USE_TRANSMIT) ///< Bytes reserved in front of each frame.
+#ifndef LP5024_PIPELINE_CHUNK_SIZE
+#define LP5024_PIPELINE_CHUNK_SIZE (LP5024_LED_COUNT) ///< Max. frame bytes per transaction.
+#endif
+#ifndef LP5024_PIPELINE_URGENT_SLOTS
+#define LP5024_PIPELINE_URGENT_SLOTS (4) ///< Max. number of queued urgent writes.
+#endif
+
+	/**
+	 * @brief Struct for pipeline statistics.
+	 */
+	typedef struct
+	{
+		uint32_t frames;		///< Frames transmitted since last reset.
+		uint32_t frameRate;		///< Achieved frame rate [Hz].
+		uint8_t busUtilisation;	///< Share of time the bus was transmitting [%].
+		uint32_t stalls;		///< Frames submitted while previous frame still waited for the bus.
+		uint32_t starved;		///< Transfers that completed without a frame waiting.
+		uint32_t errors;		///< Failed transfers.
+		uint32_t urgentWrites;	///< Urgent writes completed.
+		uint32_t urgentLatency;	///< Worst time from queuing to completion of an urgent write [timestamp ticks].
+	} lp5024_PipelineStats_t;
+
+	/**
+	 * @brief Struct for queued urgent write.
+	 */
+	typedef struct
+	{
+		uint8_t data[2];	///< Register address and value.
+		uint32_t timestamp;	///< Time of queuing.
+	} lp5024_UrgentWrite_t;
+
+	/**
+	 * @brief Struct for double buffered frame output.
+	 */
+	typedef struct
+	{
+		lp5024_Device_t *device;		///< Device frames are sent to.
+		const lp5024_ChannelMap_t *map;	///< Colour order of connected LEDs.
+		/** Transmit buffers, OUTx register images behind LP5024_PIPELINE_HEADER bytes. */
+		uint8_t buffer[2][LP5024_PIPELINE_HEADER + LP5024_LED_COUNT];
+		uint8_t render;											  ///< Index of buffer owned by application.
+		uint8_t transmit;										  ///< Index of buffer on the bus.
+		volatile uint8_t busy;									  ///< Transaction in progress.
+		volatile uint8_t pending;								  ///< Rendered frame waits for the bus.
+		volatile uint8_t sending;								  ///< Frame partially sent.
+		volatile uint8_t offset;								  ///< Frame bytes already sent.
+		volatile uint8_t length;								  ///< Frame or wake up bytes of current transaction.
+		volatile uint8_t urgent;								  ///< Current transaction is an urgent write.
+		uint8_t saved;											  ///< Frame byte replaced by chunk register address.
+		lp5024_UrgentWrite_t queue[LP5024_PIPELINE_URGENT_SLOTS]; ///< Urgent writes, oldest first.
+		volatile uint8_t queueHead;								  ///< Index of oldest urgent write.
+		volatile uint8_t queueCount;							  ///< Number of queued urgent writes.
+		uint8_t wake[LP5024_PIPELINE_HEADER + LP5024_REG_COUNT];  ///< Shadow copy restoring a powered down chip.
+		volatile uint8_t wakeReg;								  ///< Next register of the wake up.
+		volatile uint8_t wakeEnd;								  ///< Register behind the wake up, 0 if none runs.
+		uint32_t wakeStart;										  ///< Timestamp of wake up start.
+		volatile uint32_t transferStart;						  ///< Timestamp of current transfer.
+		volatile uint32_t busTicks;								  ///< Accumulated transfer time.
+		uint32_t windowStart;									  ///< Timestamp of last statistics reset.
+		volatile lp5024_PipelineStats_t statistics;				  ///< Raw statistics counters.
+	} lp5024_Pipeline_t;
+
+	/**
+	 * @brief 					Initialises pipeline with black frames.
+	 *
+	 * @param 	pipeline		Pipeline to initialise.
+	 * @param   device      	Struct with I2C handler and address pin status, LP5018 or LP5024.
+	 * @param 	rgb				Order of colours.
+	 *
+	 * @retval 	uint8_t			Error code, LP5024_INPUTOUTOFRANGE for other parts.
+	 */
+	uint8_t LP5024_Pipeline_Init(lp5024_Pipeline_t *pipeline, lp5024_Device_t *device, uint8_t rgb);
+	/**
+	 * @brief 					Returns buffer for rendering the next frame.
+	 *
+	 * @param 	pipeline		Pipeline handle.
+	 *
+	 * @retval 	uint8_t*		OUTx register image or NULL while submitted frame waits for the bus.
+	 */
+	uint8_t *LP5024_Pipeline_GetFrame(lp5024_Pipeline_t *pipeline);
+	/**
+	 * @brief 					Returns location of one RGB LED within the transmit buffer.
+	 * Colours are stored at the offsets of LP5024_Pipeline_GetChannelMap(),
+	 * e.g. via LP5024_PUT_RGB(led, map, red, green, blue).
+	 *
+	 * @param 	pipeline		Pipeline handle.
+	 * @param 	rgbLED			Selected LED.
+	 *
+	 * @retval 	uint8_t*		First register of LED or NULL while submitted frame waits for the bus.
+	 */
+	uint8_t *LP5024_Pipeline_GetLED(lp5024_Pipeline_t *pipeline, uint8_t rgbLED);
+	/**
+	 * @brief 					Returns register offsets of the configured colour order.
+	 *
+	 * @param 	pipeline		Pipeline handle.
+	 *
+	 * @retval 	lp5024_ChannelMap_t*	Offsets of red, green and blue.
+	 */
+	const lp5024_ChannelMap_t *LP5024_Pipeline_GetChannelMap(lp5024_Pipeline_t *pipeline);
+	/**
+	 * @brief 					Sets LED colour in RGB Format in the transmit buffer.
+	 *
+	 * @param 	pipeline		Pipeline handle.
+	 * @param 	rgbLED			Selected LED.
+	 * @param 	red				Red value.
+	 * @param 	green			Green value.
+	 * @param 	blue 			Blue value.
+	 *
+	 * @retval 	uint8_t			Error code, HAL_BUSY while submitted frame waits for the bus.
+	 */
+	uint8_t LP5024_Pipeline_SetLEDColourRGB(lp5024_Pipeline_t *pipeline, uint8_t rgbLED, uint8_t red, uint8_t green, uint8_t blue);
+	/**
+	 * @brief 					Submits rendered frame.
+	 * Starts the transfer immediately if the bus is idle,
+	 * otherwise the frame is sent on completion of the current transfer.
+	 *
+	 * @param 	pipeline		Pipeline handle.
+	 *
+	 * @retval 	uint8_t			Error code, HAL_BUSY if previous frame still waits.
+	 */
+	uint8_t LP5024_Pipeline_Submit(lp5024_Pipeline_t *pipeline);
+	/**
+	 * @brief 					Marks rendered frame as pending without starting the transfer.
+	 * Used by coordinators that share the bus, LP5024_Pipeline_Submit() starts it later.
+	 *
+	 * @param 	pipeline		Pipeline handle.
+	 *
+	 * @retval 	uint8_t			Error code, HAL_BUSY if a frame is pending or on the bus.
+	 */
+	uint8_t LP5024_Pipeline_Queue(lp5024_Pipeline_t *pipeline);
+	/**
+	 * @brief 					Writes one register ahead of all queued frame data.
+	 * Sent immediately on an idle bus, otherwise after the current transaction.
+	 *
+	 * @param 	pipeline		Pipeline handle.
+	 * @param 	regAdress		Register address.
+	 * @param 	value			Register value.
+	 *
+	 * @retval 	uint8_t			Error code, HAL_BUSY if urgent queue is full.
+	 */
+	uint8_t LP5024_Pipeline_WriteUrgent(lp5024_Pipeline_t *pipeline, uint8_t regAdress, uint8_t value);
+	/**
+	 * @brief 					Handles transfer completion, call from HAL_I2C_MemTxCpltCallback.
+	 *
+	 * @param 	pipeline		Pipeline handle.
+	 * @param 	hi2c			I2C handler of completed transfer.
+	 */
+	void LP5024_Pipeline_TxCpltCallback(lp5024_Pipeline_t *pipeline, I2C_HandleTypeDef *hi2c);
+	/**
+	 * @brief 					Handles transfer errors, call from HAL_I2C_ErrorCallback.
+	 *
+	 * @param 	pipeline		Pipeline handle.
+	 * @param 	hi2c			I2C handler of failed transfer.
+	 */
+	void LP5024_Pipeline_ErrorCallback(lp5024_Pipeline_t *pipeline, I2C_HandleTypeDef *hi2c);
+	/**
+	 * @brief 					Reads statistics since last reset.
+	 *
+	 * @param 	pipeline		Pipeline handle.
+	 * @param 	statistics		Destination of statistics.
+	 * @param 	reset			Restarts measurement window if not zero.
+	 */
+	void LP5024_Pipeline_GetStats(lp5024_Pipeline_t *pipeline, lp5024_PipelineStats_t *statistics, uint8_t reset);
+	/**
+	 * @brief 					Sets LED colour in RGB Format in a register image.
+	 *
+	 * @param 	frame			OUTx register image.
+	 * @param 	rgb				Order of colours.
+	 * @param 	rgbLED			Selected LED.
+	 * @param 	red				Red value.
+	 * @param 	green			Green value.
+	 * @param 	blue 			Blue value.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Frame_SetLEDColourRGB(uint8_t *frame, uint8_t rgb, uint8_t rgbLED, uint8_t red, uint8_t green, uint8_t blue);
+	/**
+	 * @brief 					Sets LED colour in HSB Format in a register image.
+	 *
+	 * @param 	frame			OUTx register image.
+	 * @param 	rgb				Order of colours.
+	 * @param 	rgbLED			Selected LED.
+	 * @param 	hue				Hue setting.
+	 * @param 	saturation		Saturation setting.
+	 * @param 	brightness 		Brightness setting.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Frame_SetLEDColourHSB(uint8_t *frame, uint8_t rgb, uint8_t rgbLED, uint16_t hue, uint8_t saturation, uint8_t brightness);
+
+	/**
+	 * @}
+	 */
+
+	/**
+	 * @}
+	 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CUSTOM_DRIVERS_INC_LP5024_PIPELINE_H_ */
@@ -0,0 +1,129 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Scheduler.h
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Headerfile for frame pacing of LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Frames of a pipeline are sent at a fixed frame rate. Every transfer of the
+ * driver on the same bus is accounted via the transfer hook of that bus,
+ * including the register setters, so every bus may have its own scheduler.
+ * A frame is only admitted to a slot if its cost fits into the bandwidth
+ * left by the other traffic. Frames rendered while no slot is free are
+ * merged into the next admitted frame instead of being queued.
+ *
+ * Cost of a transfer:
+ * (LP5024_SCHEDULER_OVERHEAD_BITS + 9 * bytes) / bus speed
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#ifndef CUSTOM_DRIVERS_INC_LP5024_SCHEDULER_H_
+#define CUSTOM_DRIVERS_INC_LP5024_SCHEDULER_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	/** @addtogroup IC_Drivers
+	 * @{
+	 */
+
+	/** @addtogroup LED_Driver
+	 * @{
+	 */
+
+// Includes
+#include "LP5024_Pipeline.h"
+
+/** Bits per transaction besides data: start, address, register, stop. */
+#define LP5024_SCHEDULER_OVERHEAD_BITS (20)
+
+	/**
+	 * @brief Struct for scheduler statistics.
+	 */
+	typedef struct
+	{
+		uint32_t frames;	///< Frames admitted to the bus.
+		uint32_t dropped;	///< Slots that could not carry a waiting frame.
+		uint32_t merged;	///< Frames replaced by a newer render before reaching the bus.
+		uint32_t jitterMax;	///< Max. delay of a slot against its target time [timestamp ticks].
+		uint32_t jitterSum;	///< Sum of slot delays, divide by slots for the mean.
+		uint32_t slots;		///< Slots served.
+		uint8_t busLoad;	///< Bus usage of all traffic in the last slot [%].
+	} lp5024_SchedulerStats_t;
+
+	/**
+	 * @brief Struct for frame pacing.
+	 */
+	typedef struct
+	{
+		lp5024_Pipeline_t *pipeline;		///< Pipeline frames are sent with.
+		uint32_t busSpeed;					///< I2C clock [Hz].
+		uint32_t period;					///< Slot length [timestamp ticks].
+		uint32_t periodMicros;				///< Slot length [us].
+		uint32_t nextSlot;					///< Target time of next slot.
+		uint8_t requested;					///< Rendered frame waits for a slot.
+		volatile uint8_t own;				///< Scheduler itself is submitting.
+		volatile uint32_t trafficMicros;	///< Bus time of other transfers since last slot [us].
+		lp5024_SchedulerStats_t statistics;	///< Statistics counters.
+	} lp5024_Scheduler_t;
+
+	/**
+	 * @brief 					Initialises scheduler and installs its transfer hook on the bus of the pipeline.
+	 *
+	 * @param 	scheduler		Scheduler to initialise.
+	 * @param 	pipeline		Initialised pipeline.
+	 * @param 	busSpeed		I2C clock [Hz].
+	 * @param 	frameRate		Target frame rate [Hz].
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Scheduler_Init(lp5024_Scheduler_t *scheduler, lp5024_Pipeline_t *pipeline, uint32_t busSpeed, uint32_t frameRate);
+	/**
+	 * @brief 					Returns bus time of one transaction.
+	 *
+	 * @param 	scheduler		Scheduler handle.
+	 * @param 	length			Number of data bytes.
+	 *
+	 * @retval 	uint32_t		Cost [us].
+	 */
+	uint32_t LP5024_Scheduler_Cost(lp5024_Scheduler_t *scheduler, uint16_t length);
+	/**
+	 * @brief 					Marks the frame rendered into the pipeline as ready.
+	 *
+	 * @param 	scheduler		Scheduler handle.
+	 */
+	void LP5024_Scheduler_Request(lp5024_Scheduler_t *scheduler);
+	/**
+	 * @brief 					Sends waiting frame if its slot is due and the bus has room, call periodically.
+	 *
+	 * @param 	scheduler		Scheduler handle.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Scheduler_Tick(lp5024_Scheduler_t *scheduler);
+	/**
+	 * @brief 					Reads statistics.
+	 *
+	 * @param 	scheduler		Scheduler handle.
+	 * @param 	statistics		Destination of statistics.
+	 * @param 	reset			Clears counters if not zero.
+	 */
+	void LP5024_Scheduler_GetStats(lp5024_Scheduler_t *scheduler, lp5024_SchedulerStats_t *statistics, uint8_t reset);
+
+	/**
+	 * @}
+	 */
+
+	/**
+	 * @}
+	 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CUSTOM_DRIVERS_INC_LP5024_SCHEDULER_H_ */
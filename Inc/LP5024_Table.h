@@ -0,0 +1,195 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Table.h
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Headerfile for device table of many LP5024 LED driver ICs.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * State of all chips is kept in contiguous arrays indexed by a small handle.
+ * OUTx images of neighbouring chips follow each other, so a panel update
+ * walks memory linearly. Configuration is mirrored in shadow registers, so
+ * setters need no read back.
+ *
+ * Chips of a table have no lp5024_Shadow_t. Their writes bypass idle power
+ * down, health check and limiter, which need a device with shadow; do not
+ * drive a chip through both a table and such a device.
+ *
+ * RAM per chip: LP5024_TABLE_BYTES_PER_DEVICE
+ * (38 bytes with 4 byte pointers, 42 bytes with 8 byte pointers).
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#ifndef CUSTOM_DRIVERS_INC_LP5024_TABLE_H_
+#define CUSTOM_DRIVERS_INC_LP5024_TABLE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	/** @addtogroup IC_Drivers
+	 * @{
+	 */
+
+	/** @addtogroup LED_Driver
+	 * @{
+	 */
+
+// Includes
+#include "LP5024.h"
+
+#ifndef LP5024_TABLE_MAX_DEVICES
+#define LP5024_TABLE_MAX_DEVICES (16) ///< Max. number of chips, up to 255.
+#endif
+
+/** RAM used per chip. */
+#define LP5024_TABLE_BYTES_PER_DEVICE (sizeof(I2C_HandleTypeDef *) + 2 + LP5024_RGBLED_COUNT + LP5024_LED_COUNT)
+
+	/**
+	 * @brief Handle of a chip within the table.
+	 */
+	typedef uint8_t lp5024_Handle_t;
+
+	/**
+	 * @brief Struct of arrays for all chips of an installation.
+	 */
+	typedef struct
+	{
+		uint8_t frame[LP5024_TABLE_MAX_DEVICES][LP5024_LED_COUNT];		   ///< OUTx images.
+		uint8_t brightness[LP5024_TABLE_MAX_DEVICES][LP5024_RGBLED_COUNT]; ///< RGBx brightness shadows.
+		I2C_HandleTypeDef *hi2c[LP5024_TABLE_MAX_DEVICES];				   ///< I2C handlers.
+		uint8_t a0[LP5024_TABLE_MAX_DEVICES];							   ///< Address pin status.
+		uint8_t config[LP5024_TABLE_MAX_DEVICES];						   ///< Configuration register shadows.
+		uint32_t dirty[(LP5024_TABLE_MAX_DEVICES + 31) / 32];			   ///< Chips with changed OUTx image.
+		uint8_t count;													   ///< Number of chips.
+	} lp5024_DeviceTable_t;
+
+	/**
+	 * @brief 					Initialises empty table.
+	 *
+	 * @param 	table			Table to initialise.
+	 */
+	void LP5024_Table_Init(lp5024_DeviceTable_t *table);
+	/**
+	 * @brief 					Adds chip with reset register state.
+	 *
+	 * @param 	table			Table handle.
+	 * @param 	hi2c			I2C handler.
+	 * @param 	a0				Address pin status.
+	 * @param 	handle			Destination of chip handle.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Table_Add(lp5024_DeviceTable_t *table, I2C_HandleTypeDef *hi2c, lp5024_A0_t a0, lp5024_Handle_t *handle);
+	/**
+	 * @brief 					Fills device struct for use with the single chip API.
+	 *
+	 * @param 	table			Table handle.
+	 * @param 	handle			Chip handle.
+	 * @param   device      	Destination struct.
+	 */
+	void LP5024_Table_GetDevice(lp5024_DeviceTable_t *table, lp5024_Handle_t handle, lp5024_Device_t *device);
+	/**
+	 * @brief 					Returns OUTx image of a chip for direct rendering, marks it changed.
+	 *
+	 * @param 	table			Table handle.
+	 * @param 	handle			Chip handle.
+	 *
+	 * @retval 	uint8_t*		OUTx image, NULL for an invalid handle.
+	 */
+	uint8_t *LP5024_Table_GetFrame(lp5024_DeviceTable_t *table, lp5024_Handle_t handle);
+	/**
+	 * @brief 					Marks OUTx image of a chip changed, e.g. after rendering through a saved frame pointer.
+	 *
+	 * @param 	table			Table handle.
+	 * @param 	handle			Chip handle.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Table_MarkDirty(lp5024_DeviceTable_t *table, lp5024_Handle_t handle);
+	/**
+	 * @brief 					Checks if OUTx image of a chip changed since its last flush.
+	 *
+	 * @param 	table			Table handle.
+	 * @param 	handle			Chip handle.
+	 *
+	 * @retval 	uint8_t			1 if changed, 0 if unchanged or invalid handle.
+	 */
+	uint8_t LP5024_Table_IsDirty(lp5024_DeviceTable_t *table, lp5024_Handle_t handle);
+	/**
+	 * @brief 					Sets LED colour in RGB Format.
+	 *
+	 * @param 	table			Table handle.
+	 * @param 	handle			Chip handle.
+	 * @param 	rgb				Order of colours.
+	 * @param 	rgbLED			Selected LED.
+	 * @param 	red				Red value.
+	 * @param 	green			Green value.
+	 * @param 	blue 			Blue value.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Table_SetLEDColourRGB(lp5024_DeviceTable_t *table, lp5024_Handle_t handle, uint8_t rgb, uint8_t rgbLED, uint8_t red, uint8_t green, uint8_t blue);
+	/**
+	 * @brief 					Sets all LEDs of a range of chips to one colour.
+	 *
+	 * @param 	table			Table handle.
+	 * @param 	first			Handle of first chip.
+	 * @param 	count			Number of chips.
+	 * @param 	rgb				Order of colours.
+	 * @param 	red				Red value.
+	 * @param 	green			Green value.
+	 * @param 	blue 			Blue value.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Table_FillRGB(lp5024_DeviceTable_t *table, lp5024_Handle_t first, uint8_t count, uint8_t rgb, uint8_t red, uint8_t green, uint8_t blue);
+	/**
+	 * @brief 					Sends changed OUTx images of a range of chips, one burst per chip.
+	 *
+	 * @param 	table			Table handle.
+	 * @param 	first			Handle of first chip.
+	 * @param 	count			Number of chips.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Table_Flush(lp5024_DeviceTable_t *table, lp5024_Handle_t first, uint8_t count);
+	/**
+	 * @brief 					Sets brightness of all RGB LEDs of a range of chips, one burst per chip.
+	 *
+	 * @param 	table			Table handle.
+	 * @param 	first			Handle of first chip.
+	 * @param 	count			Number of chips.
+	 * @param 	brightness		Brightness of RGB LED 0 to 7.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Table_SetRGBLEDBrightness(lp5024_DeviceTable_t *table, lp5024_Handle_t first, uint8_t count, const uint8_t *brightness);
+	/**
+	 * @brief 					Changes bits of the configuration register of a range of chips.
+	 *
+	 * @param 	table			Table handle.
+	 * @param 	first			Handle of first chip.
+	 * @param 	count			Number of chips.
+	 * @param 	mask			Bits to change.
+	 * @param 	bits			New value of changed bits.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Table_UpdateConfig(lp5024_DeviceTable_t *table, lp5024_Handle_t first, uint8_t count, uint8_t mask, uint8_t bits);
+
+	/**
+	 * @}
+	 */
+
+	/**
+	 * @}
+	 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CUSTOM_DRIVERS_INC_LP5024_TABLE_H_ */
@@ -0,0 +1,198 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Transition.h
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Headerfile for time based transitions of LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * A transition moves an RGB LED from its current value to a target within a
+ * duration. Every tick samples the easing curve at the current timestamp and
+ * renders the result into the pipeline, values the bus could not take in
+ * time are skipped, so a transition never takes longer on a slow bus.
+ *
+ * Starting a transition on an LED that is already moving starts from the
+ * value reached, so retargeting does not jump. Cancelling keeps the value
+ * reached.
+ *
+ * Colour transitions run in RGB or HSB space, brightness transitions move
+ * the RGBx brightness register via urgent pipeline writes.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#ifndef CUSTOM_DRIVERS_INC_LP5024_TRANSITION_H_
+#define CUSTOM_DRIVERS_INC_LP5024_TRANSITION_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+	/** @addtogroup IC_Drivers
+	 * @{
+	 */
+
+	/** @addtogroup LED_Driver
+	 * @{
+	 */
+
+// Includes
+#include "LP5024_Pipeline.h"
+
+	/**
+	 * @brief Enum for easing curves.
+	 */
+	typedef enum
+	{
+		LP5024_EaseLinear,
+		LP5024_EaseIn,
+		LP5024_EaseOut,
+		LP5024_EaseInOut
+	} lp5024_Easing_t;
+
+	/**
+	 * @brief Enum for value space of a transition.
+	 */
+	typedef enum
+	{
+		LP5024_TransitionNone,
+		LP5024_TransitionRGB,
+		LP5024_TransitionHSB,
+		LP5024_TransitionBrightness
+	} lp5024_TransitionSpace_t;
+
+	/**
+	 * @brief Struct for one running transition.
+	 */
+	typedef struct
+	{
+		uint8_t space;	   ///< Value space of last start, see lp5024_TransitionSpace_t.
+		uint8_t active;	   ///< Transition is running.
+		uint8_t easing;	   ///< Easing curve, see lp5024_Easing_t.
+		uint32_t start;	   ///< Timestamp of start.
+		uint32_t duration; ///< Duration [timestamp ticks].
+		int16_t from[3];   ///< Start values.
+		int16_t to[3];	   ///< Target values.
+		int16_t value[3];  ///< Values of last sample.
+	} lp5024_Transition_t;
+
+	/**
+	 * @brief Struct for transition statistics.
+	 */
+	typedef struct
+	{
+		uint32_t ticks;	  ///< Ticks with at least one running transition.
+		uint32_t skipped; ///< Ticks the pipeline could not take a frame.
+		uint32_t samples; ///< Sampled transitions.
+		uint32_t cycles;  ///< Cycles spent sampling, divide by samples for the cost per transition.
+	} lp5024_TransitionStats_t;
+
+	/**
+	 * @brief Struct for transitions of all RGB LEDs of a pipeline.
+	 */
+	typedef struct
+	{
+		lp5024_Pipeline_t *pipeline;						 ///< Pipeline frames are sent with.
+		lp5024_Transition_t colour[LP5024_RGBLED_COUNT];	 ///< Colour transitions.
+		lp5024_Transition_t brightness[LP5024_RGBLED_COUNT]; ///< Brightness transitions.
+		uint8_t rgb[LP5024_RGBLED_COUNT][3];				 ///< Current colours, red, green, blue.
+		uint8_t level[LP5024_RGBLED_COUNT];					 ///< Current RGBx brightness.
+		lp5024_TransitionStats_t statistics;				 ///< Statistics counters.
+	} lp5024_Transitions_t;
+
+	/**
+	 * @brief 					Initialises transitions with all LEDs off and reset brightness.
+	 *
+	 * @param 	transitions		Transitions to initialise.
+	 * @param 	pipeline		Initialised pipeline.
+	 */
+	void LP5024_Transition_Init(lp5024_Transitions_t *transitions, lp5024_Pipeline_t *pipeline);
+	/**
+	 * @brief 					Moves LED colour to a target in RGB space.
+	 *
+	 * @param 	transitions		Transitions handle.
+	 * @param 	rgbLED			Selected LED.
+	 * @param 	red				Red target.
+	 * @param 	green			Green target.
+	 * @param 	blue 			Blue target.
+	 * @param 	duration		Duration [timestamp ticks].
+	 * @param 	easing			Easing curve.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Transition_StartRGB(lp5024_Transitions_t *transitions, uint8_t rgbLED, uint8_t red, uint8_t green, uint8_t blue, uint32_t duration, lp5024_Easing_t easing);
+	/**
+	 * @brief 					Moves LED colour to a target in HSB space, hue takes the shorter way.
+	 *
+	 * @param 	transitions		Transitions handle.
+	 * @param 	rgbLED			Selected LED.
+	 * @param 	hue				Hue target.
+	 * @param 	saturation		Saturation target.
+	 * @param 	brightness		Brightness target.
+	 * @param 	duration		Duration [timestamp ticks].
+	 * @param 	easing			Easing curve.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Transition_StartHSB(lp5024_Transitions_t *transitions, uint8_t rgbLED, uint16_t hue, uint8_t saturation, uint8_t brightness, uint32_t duration, lp5024_Easing_t easing);
+	/**
+	 * @brief 					Moves RGBx brightness register to a target.
+	 *
+	 * @param 	transitions		Transitions handle.
+	 * @param 	rgbLED			Selected LED.
+	 * @param 	brightness		Brightness target.
+	 * @param 	duration		Duration [timestamp ticks].
+	 * @param 	easing			Easing curve.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Transition_StartBrightness(lp5024_Transitions_t *transitions, uint8_t rgbLED, uint8_t brightness, uint32_t duration, lp5024_Easing_t easing);
+	/**
+	 * @brief 					Stops all transitions of an LED at the value reached.
+	 *
+	 * @param 	transitions		Transitions handle.
+	 * @param 	rgbLED			Selected LED.
+	 *
+	 * @retval 	uint8_t			Error code.
+	 */
+	uint8_t LP5024_Transition_Cancel(lp5024_Transitions_t *transitions, uint8_t rgbLED);
+	/**
+	 * @brief 					Checks for running transitions of an LED.
+	 *
+	 * @param 	transitions		Transitions handle.
+	 * @param 	rgbLED			Selected LED.
+	 *
+	 * @retval 	uint8_t			1 if a transition is running.
+	 */
+	uint8_t LP5024_Transition_IsActive(lp5024_Transitions_t *transitions, uint8_t rgbLED);
+	/**
+	 * @brief 					Samples running transitions and submits the frame, call periodically.
+	 *
+	 * @param 	transitions		Transitions handle.
+	 *
+	 * @retval 	uint8_t			Error code, HAL_BUSY if the pipeline could not take the frame.
+	 */
+	uint8_t LP5024_Transition_Tick(lp5024_Transitions_t *transitions);
+	/**
+	 * @brief 					Reads statistics.
+	 *
+	 * @param 	transitions		Transitions handle.
+	 * @param 	statistics		Destination of statistics.
+	 * @param 	reset			Clears counters if not zero.
+	 */
+	void LP5024_Transition_GetStats(lp5024_Transitions_t *transitions, lp5024_TransitionStats_t *statistics, uint8_t reset);
+
+	/**
+	 * @}
+	 */
+
+	/**
+	 * @}
+	 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CUSTOM_DRIVERS_INC_LP5024_TRANSITION_H_ */
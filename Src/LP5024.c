@@ -17,342 +17,439 @@
  */
 
 #include "LP5024.h"
+#include <string.h> // For shadow initialisation and copies.
 
-uint8_t LP5024_ReadI2C(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data)
+const lp5024_ChannelMap_t LP5024_ChannelMaps[6] = {
+	{0, 1, 2}, // LP5024_RGB
+	{0, 2, 1}, // LP5024_RBG
+	{1, 0, 2}, // LP5024_GRB
+	{2, 0, 1}, // LP5024_GBR
+	{2, 1, 0}, // LP5024_BGR
+	{1, 2, 0}, // LP5024_BRG
+};
+
+const lp5024_Part_t LP5024_Parts[6] = {
+	{0x14, 3, 0x00, 0x01, 0x02, 0x03, 0x04, 0x07, 0x0B, 0x17},  // LP5024_LP5009
+	{0x14, 4, 0x00, 0x01, 0x02, 0x03, 0x04, 0x07, 0x0B, 0x17},  // LP5024_LP5012
+	{0x28, 6, 0x00, 0x01, 0x02, 0x03, 0x04, 0x07, 0x0F, 0x27},  // LP5024_LP5018
+	{0x28, 8, 0x00, 0x01, 0x02, 0x03, 0x04, 0x07, 0x0F, 0x27},  // LP5024_LP5024
+	{0x30, 10, 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x14, 0x38}, // LP5024_LP5030
+	{0x30, 12, 0x00, 0x01, 0x02, 0x04, 0x05, 0x08, 0x14, 0x38}, // LP5024_LP5036
+};
+
+/** Policy of devices without own policy. */
+static const lp5024_Policy_t LP5024_DefaultPolicy = {LP5024_I2C_TIMEOUT, LP5024_I2C_MAX_ATTEMPTS, LP5024_I2C_ATTEMPT_DELAY};
+
+/** Timeout and retry policy of a device. */
+#define LP5024_POLICY(device) ((device)->policy != NULL ? (device)->policy : &LP5024_DefaultPolicy)
+
+/** Register transactions of the transaction core. */
+typedef enum
 {
-	return HAL_I2C_Mem_Read(device->hi2c, (LP5024_ADDRESS + device->a0) << 1, regAdress, I2C_MEMADD_SIZE_8BIT, data, 1, LP5024_I2C_TIMEOUT);
-}
+	LP5024_OperationRead,
+	LP5024_OperationWrite,
+	LP5024_OperationWriteRaw
+} lp5024_Operation_t;
 
-uint8_t LP5024_WriteI2C(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data)
+/* Observer of bus traffic. */
+static struct
 {
-	return HAL_I2C_Mem_Write(device->hi2c, (LP5024_ADDRESS + device->a0) << 1, regAdress, I2C_MEMADD_SIZE_8BIT, data, 1, LP5024_I2C_TIMEOUT);
-}
+	I2C_HandleTypeDef *hi2c;
+	lp5024_TransferHook_t hook;
+	void *context;
+} transferHooks[LP5024_MAX_TRANSFER_HOOKS];
 
-void HSVtoRGB(uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t hue, uint8_t saturation, uint8_t brightness)
+uint8_t LP5024_SetTransferHook(I2C_HandleTypeDef *hi2c, lp5024_TransferHook_t hook, void *context)
 {
-	float c, x, m;
-	m = brightness; // Cast brightness to float.
-	m /= 100;		// Normalise brightness.
-	c = saturation; // Cast saturation to float.
-	c /= 100;		// Normalise saturation.
-	c *= m;			// Calculates c (saturation * brightness).
-	m -= c;			// Calculates m (brightness - c).
-	x = hue;		// Cast hue to float.
-	/* Calculates x (c * (1 - |(hue/60) mod 2 -1|). */
-	x = c * (1 - abs(((int)(x / 60) % 2) - 1));
-	if (hue < 60)
-	{
-		*red = (uint8_t)((c + m) * 255);
-		*green = (uint8_t)((x + m) * 255);
-		*blue = (uint8_t)(m * 255);
-	}
-	else if (hue < 120)
-	{
-		*red = (uint8_t)((x + m) * 255);
-		*green = (uint8_t)((c + m) * 255);
-		*blue = (uint8_t)(m * 255);
-	}
-	else if (hue < 180)
+	uint8_t target = LP5024_MAX_TRANSFER_HOOKS;
+	for (uint8_t slot = 0; slot < LP5024_MAX_TRANSFER_HOOKS; slot++)
 	{
-		*red = (uint8_t)(m * 255);
-		*green = (uint8_t)((c + m) * 255);
-		*blue = (uint8_t)((x + m) * 255);
+		if (transferHooks[slot].hook != NULL && transferHooks[slot].hi2c == hi2c)
+		{ /* Replaces or removes observer of the same unit. */
+			target = slot;
+			break;
+		}
+		if (transferHooks[slot].hook == NULL && target == LP5024_MAX_TRANSFER_HOOKS)
+		{
+			target = slot;
+		}
 	}
-	else if (hue < 240)
+	if (target == LP5024_MAX_TRANSFER_HOOKS)
+	{ /* Checks for input errors. */
+		return hook == NULL ? LP5024_SUCCESS : LP5024_INPUTOUTOFRANGE;
+	}
+	/* Hook is cleared first, so a transfer interrupt never sees a half written slot. */
+	transferHooks[target].hook = NULL;
+	transferHooks[target].hi2c = hi2c;
+	transferHooks[target].context = context;
+	transferHooks[target].hook = hook;
+	return LP5024_SUCCESS;
+}
+
+void LP5024_NotifyTransfer(lp5024_Device_t *device, uint16_t length)
+{
+	for (uint8_t slot = 0; slot < LP5024_MAX_TRANSFER_HOOKS; slot++)
 	{
-		*red = (uint8_t)(m * 255);
-		*green = (uint8_t)((x + m) * 255);
-		*blue = (uint8_t)((c + m) * 255);
+		lp5024_TransferHook_t hook = transferHooks[slot].hook;
+		if (hook != NULL && (transferHooks[slot].hi2c == NULL || transferHooks[slot].hi2c == device->hi2c))
+		{
+			hook(transferHooks[slot].context, device, length);
+		}
 	}
-	else if (hue < 300)
+}
+
+/* Serialisation of bus transactions. */
+static lp5024_LockHook_t lockHook = NULL;
+static lp5024_LockHook_t unlockHook = NULL;
+static void *lockContext = NULL;
+static lp5024_LockStats_t lockStatistics;
+
+void LP5024_SetLockHooks(lp5024_LockHook_t lock, lp5024_LockHook_t unlock, void *context)
+{
+	lockContext = context;
+	unlockHook = unlock;
+	lockHook = lock;
+}
+
+void LP5024_Lock(lp5024_Device_t *device)
+{
+	if (lockHook != NULL)
 	{
-		*red = (uint8_t)((x + m) * 255);
-		*green = (uint8_t)(m * 255);
-		*blue = (uint8_t)((c + m) * 255);
+		uint32_t cycles = LP5024_CYCLES();
+		lockHook(lockContext, device);
+		/* Counted while holding the lock. */
+		cycles = LP5024_CYCLES() - cycles;
+		lockStatistics.locks++;
+		lockStatistics.waitCycles += cycles;
+		if (cycles > lockStatistics.worstWait)
+		{
+			lockStatistics.worstWait = cycles;
+		}
 	}
-	else
+}
+
+void LP5024_Unlock(lp5024_Device_t *device)
+{
+	if (unlockHook != NULL)
 	{
-		*red = (uint8_t)((c + m) * 255);
-		*green = (uint8_t)(m * 255);
-		*blue = (uint8_t)((x + m) * 255);
+		unlockHook(lockContext, device);
 	}
 }
 
-uint8_t LP5024_Enable(lp5024_Device_t *device, lp5024_Enable_t active)
+void LP5024_GetLockStats(lp5024_LockStats_t *statistics, uint8_t reset)
 {
-	/* Holds i2c status for error catching. */
-	uint8_t status = 0;
-	if (active > 1)
-	{ /* Checks for input errors. */
-		return LP5024_INPUTOUTOFRANGE;
-	}
-	/* Shifts bit in right position. */
-	active = active << 6;
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	*statistics = lockStatistics;
+	if (reset)
 	{
-		/* Sends changed register settings to chip. */
-		status = LP5024_WriteI2C(device, LP5024_REG_ENABLE, &active);
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+		memset(&lockStatistics, 0, sizeof(lockStatistics));
 	}
-	return status;
 }
 
-uint8_t LP5024_SetLEDGlobalOff(lp5024_Device_t *device, lp5024_LED_OnOff_t active)
+/* Guarded I2C units. */
+static lp5024_BusGuard_t *busGuards[LP5024_MAX_BUS_GUARDS];
+
+uint8_t LP5024_AddBusGuard(lp5024_BusGuard_t *guard, I2C_HandleTypeDef *hi2c, uint8_t threshold, uint32_t holdoff, lp5024_RecoveryHook_t hook, void *context)
 {
-	/* Holds data for i2c communication. */
-	uint8_t data = 0;
-	/* Holds i2c status for error catching. */
-	uint8_t status = 0;
-	if (active > 1)
-	{ /* Checks for input errors. */
+	/* Checks for input errors. */
+	if (threshold == 0 || hook == NULL)
+	{
 		return LP5024_INPUTOUTOFRANGE;
 	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	for (uint8_t slot = 0; slot < LP5024_MAX_BUS_GUARDS; slot++)
 	{
-		/* Reads current setting of register. */
-		status = LP5024_ReadI2C(device, LP5024_REG_CONFIG, &data);
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
+		if (busGuards[slot] == NULL || busGuards[slot]->hi2c == hi2c)
+		{ /* Free slot or replaces guard of the same unit, its epoch is kept so shadows are not restored again. */
+			uint32_t epoch = busGuards[slot] != NULL ? busGuards[slot]->epoch : 0;
+			memset(guard, 0, sizeof(*guard));
+			guard->epoch = epoch;
+			guard->hi2c = hi2c;
+			guard->hook = hook;
+			guard->context = context;
+			guard->threshold = threshold;
+			guard->holdoff = holdoff;
+			busGuards[slot] = guard;
+			return LP5024_SUCCESS;
 		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
 	}
-	/* Catches case when all attempts failed and returns last error code. */
-	if (status > HAL_OK)
+	return LP5024_INPUTOUTOFRANGE;
+}
+
+void LP5024_GetBusGuardStats(lp5024_BusGuard_t *guard, lp5024_BusGuardStats_t *statistics, uint8_t reset)
+{
+	*statistics = guard->statistics;
+	if (reset)
 	{
-		return status;
+		memset(&guard->statistics, 0, sizeof(guard->statistics));
 	}
-	/* Combines current value of register with value that has to be changed. */
-	data = (data & (~0b1)) | active;
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+}
+
+/* Finds guard of an I2C unit. */
+static lp5024_BusGuard_t *LP5024_FindBusGuard(I2C_HandleTypeDef *hi2c)
+{
+	for (uint8_t slot = 0; slot < LP5024_MAX_BUS_GUARDS && busGuards[slot] != NULL; slot++)
 	{
-		/* Sends changed register settings to chip. */
-		status = LP5024_WriteI2C(device, LP5024_REG_CONFIG, &data);
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
+		if (busGuards[slot]->hi2c == hi2c)
+		{
+			return busGuards[slot];
 		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
 	}
-	return status;
+	return NULL;
 }
 
-uint8_t LP5024_SetMaxCurrent(lp5024_Device_t *device, lp5024_MaxCurrent_t current)
+/* Counts consecutive busy and timeout results, returns 1 if the bus is considered hung. */
+static uint8_t LP5024_CountResult(lp5024_BusGuard_t *guard, uint8_t status)
 {
-	/* Holds data for i2c communication. */
-	uint8_t data = 0;
-	/* Holds i2c status for error catching. */
-	uint8_t status = 0;
-	if (current > 1)
-	{ /* Checks for input errors. */
-		return LP5024_INPUTOUTOFRANGE;
+	if (status != HAL_BUSY && status != HAL_TIMEOUT)
+	{ /* Bus answered, even if the device did not acknowledge. */
+		guard->failures = 0;
+		return 0;
 	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	if (guard->failures == 0)
 	{
-		/* Reads current setting of register. */
-		status = LP5024_ReadI2C(device, LP5024_REG_CONFIG, &data);
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+		guard->failStart = LP5024_TIMESTAMP();
 	}
-	/* Catches case when all attempts failed and returns last error code. */
-	if (status > HAL_OK)
+	if (guard->failures < UINT8_MAX)
 	{
-		return status;
+		guard->failures++;
 	}
-	/* Combines current value of register with value that has to be changed. */
-	data = (data & (~(0b1 << 1))) | (current << 1);
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
-	{
-		/* Sends changed register settings to chip. */
-		status = LP5024_WriteI2C(device, LP5024_REG_CONFIG, &data);
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+	if (!guard->hung && guard->failures >= guard->threshold)
+	{ /* Allows the first recovery attempt at once. */
+		guard->hung = 1;
+		guard->lastAttempt = LP5024_TIMESTAMP() - guard->holdoff;
+		guard->statistics.hangs++;
 	}
-	return status;
+	return guard->hung;
 }
 
-uint8_t LP5024_SetPWMDithering(lp5024_Device_t *device, lp5024_PWMDithering_t active)
+static uint8_t LP5024_WakeDevice(lp5024_Device_t *device);
+static uint8_t LP5024_RestoreShadow(lp5024_Device_t *device, uint8_t retry);
+
+uint8_t LP5024_ReadI2C(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data)
+{
+	return LP5024_ReadBurstI2C(device, regAdress, data, 1);
+}
+
+uint8_t LP5024_WriteI2C(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data)
+{
+	return LP5024_WriteBurstI2C(device, regAdress, data, 1);
+}
+
+uint8_t LP5024_ReadBurstI2C(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data, uint16_t length)
+{
+	LP5024_NotifyTransfer(device, length);
+	return HAL_I2C_Mem_Read(device->hi2c, LP5024_I2C_ADDRESS(device), regAdress, I2C_MEMADD_SIZE_8BIT, data, length, LP5024_POLICY(device)->timeout);
+}
+
+/* Writes registers without shadow handling. */
+static uint8_t LP5024_WriteRawI2C(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data, uint16_t length)
+{
+	LP5024_NotifyTransfer(device, length);
+	return HAL_I2C_Mem_Write(device->hi2c, LP5024_I2C_ADDRESS(device), regAdress, I2C_MEMADD_SIZE_8BIT, data, length, LP5024_POLICY(device)->timeout);
+}
+
+uint8_t LP5024_WriteBurstI2C(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data, uint16_t length)
 {
-	/* Holds data for i2c communication. */
-	uint8_t data = 0;
 	/* Holds i2c status for error catching. */
 	uint8_t status = 0;
-	if (active > 1)
-	{ /* Checks for input errors. */
-		return LP5024_INPUTOUTOFRANGE;
-	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	lp5024_Shadow_t *shadow = LP5024_SHADOW(device);
+	if (shadow != NULL && shadow->asleep)
 	{
-		/* Reads current setting of register. */
-		status = LP5024_ReadI2C(device, LP5024_REG_CONFIG, &data);
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
+		uint8_t visible = regAdress < LP5024_REG_BRIGHT_TOT;
+		for (uint16_t i = 0; i < length && !visible; i++)
+		{ /* Black content does not need a lit device. */
+			visible = data[i] != 0;
 		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
+		if (visible)
+		{
+			status = LP5024_WakeDevice(device);
+			if (status > HAL_OK)
+			{
+				return status;
+			}
 		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
-	}
-	/* Catches case when all attempts failed and returns last error code. */
-	if (status > HAL_OK)
-	{
-		return status;
 	}
-	/* Combines current value of register with value that has to be changed. */
-	data = (data & (~(0b1 << 2))) | (active << 2);
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	status = LP5024_WriteRawI2C(device, regAdress, data, length);
+	if (status == HAL_OK)
 	{
-		/* Sends changed register settings to chip. */
-		status = LP5024_WriteI2C(device, LP5024_REG_CONFIG, &data);
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+		LP5024_UpdateShadow(device, regAdress, data, length);
 	}
 	return status;
 }
 
-uint8_t LP5024_SetAutoIncrement(lp5024_Device_t *device, lp5024_AutoIncrement_t active)
+/* Fails fast on a hung bus, runs recovery when due and restores the device after a recovery. */
+static uint8_t LP5024_GuardBus(lp5024_BusGuard_t *guard, lp5024_Device_t *device)
 {
-	/* Holds data for i2c communication. */
-	uint8_t data = 0;
 	/* Holds i2c status for error catching. */
 	uint8_t status = 0;
-	if (active > 1)
-	{ /* Checks for input errors. */
-		return LP5024_INPUTOUTOFRANGE;
+	lp5024_Shadow_t *shadow = LP5024_SHADOW(device);
+	if (guard->hung)
+	{
+		if (LP5024_TIMESTAMP() - guard->lastAttempt < guard->holdoff)
+		{ /* Recovery not due, returns without touching the bus. */
+			guard->statistics.fastFails++;
+			return HAL_BUSY;
+		}
+		guard->lastAttempt = LP5024_TIMESTAMP();
+		if (guard->hook(guard->context, guard->hi2c) != HAL_OK)
+		{
+			guard->statistics.failedRecoveries++;
+			guard->statistics.fastFails++;
+			return HAL_BUSY;
+		}
+		guard->hung = 0;
+		guard->failures = 0;
+		guard->epoch++;
+		guard->statistics.recoveries++;
+		guard->statistics.lastRecovery = LP5024_TIMESTAMP() - guard->failStart;
+		if (guard->statistics.lastRecovery > guard->statistics.worstRecovery)
+		{
+			guard->statistics.worstRecovery = guard->statistics.lastRecovery;
+		}
+	}
+	if (shadow != NULL && shadow->busEpoch != guard->epoch)
+	{ /* Chip may have missed writes or received half of one. */
+		status = LP5024_RestoreShadow(device, 0);
+		if (status != HAL_OK)
+		{
+			LP5024_CountResult(guard, status);
+			return status;
+		}
+		/* Restored chip is awake, idle handling powers it down again. */
+		shadow->busEpoch = guard->epoch;
+		shadow->asleep = 0;
+		shadow->lastActivity = LP5024_TIMESTAMP();
+		guard->statistics.restores++;
+	}
+	return HAL_OK;
+}
+
+/** Staging state of a register. */
+#define LP5024_STAGE_IS_MARKED(stage, reg) ((stage)->staged[(reg) >> 3] & (1 << ((reg) & 7)))
+#define LP5024_STAGE_MARK(stage, reg) ((stage)->staged[(reg) >> 3] |= 1 << ((reg) & 7))
+#define LP5024_STAGE_CLEAR(stage, reg) ((stage)->staged[(reg) >> 3] &= ~(1 << ((reg) & 7)))
+
+/* Collects write in the open scope or serves read from it, returns 1 if no bus access is needed. */
+static uint8_t LP5024_Stage(lp5024_Device_t *device, lp5024_Operation_t operation, uint8_t regAdress, uint8_t *data, uint16_t length)
+{
+	lp5024_Stage_t *stage = device->stage;
+	if (regAdress + length > LP5024_PART(device)->regReset || regAdress + length > LP5024_STAGE_REG_COUNT)
+	{ /* Reset and registers beyond the part are passed to the chip. */
+		return 0;
 	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	if (operation == LP5024_OperationRead)
 	{
-		/* Reads current setting of register. */
-		status = LP5024_ReadI2C(device, LP5024_REG_CONFIG, &data);
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
+		for (uint16_t i = 0; i < length; i++)
+		{
+			if (!LP5024_STAGE_IS_MARKED(stage, regAdress + i))
+			{ /* Register has to be read from the chip. */
+				return 0;
+			}
 		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+		memcpy(data, &stage->reg[regAdress], length);
+		return 1;
 	}
-	/* Catches case when all attempts failed and returns last error code. */
-	if (status > HAL_OK)
+	memcpy(&stage->reg[regAdress], data, length);
+	for (uint16_t i = 0; i < length; i++)
 	{
-		return status;
+		LP5024_STAGE_MARK(stage, regAdress + i);
 	}
-	/* Combines current value of register with value that has to be changed. */
-	data = (data & (~(0b1 << 3))) | (active << 3);
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
-	{
-		/* Sends changed register settings to chip. */
-		status = LP5024_WriteI2C(device, LP5024_REG_CONFIG, &data);
+	stage->statistics.writes++;
+	stage->statistics.stagedBytes += length;
+	return 1;
+}
+
+/* Sends staged registers in ascending order with the fewest bursts. */
+static uint8_t LP5024_StageFlush(lp5024_Device_t *device)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = HAL_OK;
+	lp5024_Stage_t *stage = device->stage;
+	const lp5024_Shadow_t *shadow = LP5024_SHADOW(device);
+	uint8_t regConfig = LP5024_PART(device)->regConfig;
+	uint8_t reg = 0;
+	/* Without auto increment a burst lands in its first register. A burst carrying a new configuration still
+	 * runs with the old one, so both need auto increment. Without shadow the reset default is assumed. */
+	uint8_t single = (shadow != NULL && !(shadow->reg[regConfig] & (0b1 << 3))) ||
+					 (LP5024_STAGE_IS_MARKED(stage, regConfig) && !(stage->reg[regConfig] & (0b1 << 3)));
+	/* Writes below bypass the scope. */
+	device->stage = NULL;
+	while (reg < LP5024_STAGE_REG_COUNT && status == HAL_OK)
+	{
+		if (!LP5024_STAGE_IS_MARKED(stage, reg))
+		{
+			reg++;
+			continue;
+		}
+		uint8_t end = reg;
+		for (uint8_t next = reg + 1; next < LP5024_STAGE_REG_COUNT && !single; next++)
+		{
+			if (LP5024_STAGE_IS_MARKED(stage, next))
+			{ /* Resends unstaged registers in between from the shadow, cheaper than a new transaction. */
+				for (uint8_t gap = end + 1; gap < next; gap++)
+				{
+					stage->reg[gap] = shadow->reg[gap];
+				}
+				end = next;
+			}
+			else if (shadow == NULL || next >= LP5024_REG_COUNT || next - end > LP5024_STAGE_MERGE_GAP)
+			{ /* Gap can not be bridged. */
+				break;
+			}
+		}
+		status = LP5024_WriteRegisters(device, reg, &stage->reg[reg], end - reg + 1);
 		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
+		{
+			stage->statistics.transactions++;
+			stage->statistics.bytes += end - reg + 1;
+			for (; reg <= end; reg++)
+			{
+				LP5024_STAGE_CLEAR(stage, reg);
+			}
 		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
 	}
+	device->stage = stage;
 	return status;
 }
 
-uint8_t LP5024_SetAutoPowerSave(lp5024_Device_t *device, lp5024_PowerSave_t active)
+/* Runs one register transaction on the bus, repeats i2c call in case of busy i2c unit. Caller holds the lock. */
+static uint8_t LP5024_Execute(lp5024_Device_t *device, lp5024_Operation_t operation, uint8_t regAdress, uint8_t *data, uint16_t length)
 {
-	/* Holds data for i2c communication. */
-	uint8_t data = 0;
 	/* Holds i2c status for error catching. */
 	uint8_t status = 0;
-	if (active > 1)
-	{ /* Checks for input errors. */
-		return LP5024_INPUTOUTOFRANGE;
-	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	const lp5024_Policy_t *policy = LP5024_POLICY(device);
+	lp5024_BusGuard_t *guard = LP5024_FindBusGuard(device->hi2c);
+	if (guard != NULL)
 	{
-		/* Reads current setting of register. */
-		status = LP5024_ReadI2C(device, LP5024_REG_CONFIG, &data);
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
+		status = LP5024_GuardBus(guard, device);
+		if (status > HAL_OK)
+		{
+			return status;
 		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
 	}
-	/* Catches case when all attempts failed and returns last error code. */
-	if (status > HAL_OK)
-	{
-		return status;
-	}
-	/* Combines current value of register with value that has to be changed. */
-	data = (data & (~(0b1 << 4))) | (active << 4);
 	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	for (uint8_t attempt = 0; attempt <= policy->attempts; attempt++)
 	{
-		/* Sends changed register settings to chip. */
-		status = LP5024_WriteI2C(device, LP5024_REG_CONFIG, &data);
+		if (operation == LP5024_OperationRead)
+		{ /* Reads current setting of registers. */
+			status = LP5024_ReadBurstI2C(device, regAdress, data, length);
+		}
+		else if (operation == LP5024_OperationWrite)
+		{ /* Sends changed register settings to chip. */
+			status = LP5024_WriteBurstI2C(device, regAdress, data, length);
+		}
+		else
+		{ /* Sends register settings bypassing the shadow. */
+			status = LP5024_WriteRawI2C(device, regAdress, data, length);
+		}
+		if (guard != NULL && LP5024_CountResult(guard, status))
+		{ /* Recovers hung bus before the next attempt or fails fast. */
+			uint8_t recovery = LP5024_GuardBus(guard, device);
+			if (recovery > HAL_OK)
+			{
+				return recovery;
+			}
+			continue;
+		}
 		if (status == HAL_OK)
 		{ /* Breaks out of loop if successful. */
 			break;
@@ -362,590 +459,559 @@ uint8_t LP5024_SetAutoPowerSave(lp5024_Device_t *device, lp5024_PowerSave_t acti
 			return HAL_ERROR;
 		}
 		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+		HAL_Delay(policy->attemptDelay);
 	}
 	return status;
 }
 
-uint8_t LP5024_SetLogScale(lp5024_Device_t *device, lp5024_LogScale_t active)
+/* Runs one register transaction, staged while a scope is open, otherwise serialised by the lock. */
+static uint8_t LP5024_Transaction(lp5024_Device_t *device, lp5024_Operation_t operation, uint8_t regAdress, uint8_t *data, uint16_t length)
 {
-	/* Holds data for i2c communication. */
-	uint8_t data = 0;
 	/* Holds i2c status for error catching. */
 	uint8_t status = 0;
-	if (active > 1)
-	{ /* Checks for input errors. */
-		return LP5024_INPUTOUTOFRANGE;
-	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
-	{
-		/* Reads current setting of register. */
-		status = LP5024_ReadI2C(device, LP5024_REG_CONFIG, &data);
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
+	if (device->stage != NULL)
+	{ /* Staging needs no lock, a scope belongs to its caller. */
+		if (LP5024_Stage(device, operation, regAdress, data, length))
+		{ /* Served by the open scope. */
+			return HAL_OK;
+		}
+		if (operation == LP5024_OperationWrite)
+		{ /* Keeps order between staged writes and writes passed to the chip. */
+			status = LP5024_StageFlush(device);
+			if (status > HAL_OK)
+			{
+				return status;
+			}
+		}
+	}
+	LP5024_Lock(device);
+	status = LP5024_Execute(device, operation, regAdress, data, length);
+	LP5024_Unlock(device);
+	if (status == HAL_OK && operation == LP5024_OperationRead && device->stage != NULL)
+	{ /* Reads see staged values, which the chip has not received yet. */
+		for (uint16_t i = 0; i < length && regAdress + i < LP5024_STAGE_REG_COUNT; i++)
+		{
+			if (LP5024_STAGE_IS_MARKED(device->stage, regAdress + i))
+			{
+				data[i] = device->stage->reg[regAdress + i];
+			}
 		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
 	}
+	return status;
+}
+
+uint8_t LP5024_ReadRegisters(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data, uint16_t length)
+{
+	return LP5024_Transaction(device, LP5024_OperationRead, regAdress, data, length);
+}
+
+uint8_t LP5024_WriteRegisters(lp5024_Device_t *device, uint8_t regAdress, uint8_t *data, uint16_t length)
+{
+	return LP5024_Transaction(device, LP5024_OperationWrite, regAdress, data, length);
+}
+
+uint8_t LP5024_ModifyRegister(lp5024_Device_t *device, uint8_t regAdress, uint8_t mask, uint8_t bits)
+{
+	/* Holds data for i2c communication. */
+	uint8_t data = 0;
+	/* Holds i2c status for error catching. */
+	uint8_t status = 0;
+	if (device->stage != NULL)
+	{ /* Read and write go through the open scope. */
+		status = LP5024_ReadRegisters(device, regAdress, &data, 1);
+		if (status > HAL_OK)
+		{
+			return status;
+		}
+		data = (data & ~mask) | (bits & mask);
+		return LP5024_WriteRegisters(device, regAdress, &data, 1);
+	}
+	/* Keeps other clients from changing the register between read and write. */
+	LP5024_Lock(device);
+	status = LP5024_Execute(device, LP5024_OperationRead, regAdress, &data, 1);
 	/* Catches case when all attempts failed and returns last error code. */
-	if (status > HAL_OK)
+	if (status == HAL_OK)
 	{
-		return status;
+		/* Combines current value of register with value that has to be changed. */
+		data = (data & ~mask) | (bits & mask);
+		status = LP5024_Execute(device, LP5024_OperationWrite, regAdress, &data, 1);
 	}
-	/* Combines current value of register with value that has to be changed. */
-	data = (data & (~(0b1 << 5))) | (active << 5);
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	LP5024_Unlock(device);
+	return status;
+}
+
+uint8_t LP5024_Begin(lp5024_Device_t *device, lp5024_Stage_t *stage)
+{
+	if (device->stage != NULL)
+	{ /* Scopes do not nest. */
+		return HAL_BUSY;
+	}
+	memset(stage->staged, 0, sizeof(stage->staged));
+	device->stage = stage;
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Commit(lp5024_Device_t *device)
+{
+	/* Checks for input errors. */
+	if (device->stage == NULL)
 	{
-		/* Sends changed register settings to chip. */
-		status = LP5024_WriteI2C(device, LP5024_REG_CONFIG, &data);
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+		return LP5024_INPUTOUTOFRANGE;
 	}
+	/* Holds i2c status for error catching. */
+	uint8_t status = LP5024_StageFlush(device);
+	device->stage = NULL;
 	return status;
 }
 
-uint8_t LP5024_SetBankControl(lp5024_Device_t *device, lp5024_RGBLEDs_t rgbLED, lp5024_BankControl_t active)
+void LP5024_GetStageStats(lp5024_Stage_t *stage, lp5024_StageStats_t *statistics, uint8_t reset)
 {
-	/* Holds data for i2c communication. */
-	uint8_t data = 0;
-	/* Holds i2c status for error catching. */
-	uint8_t status = 0;
-	if (active > 1 || rgbLED > 7)
-	{ /* Checks for input errors. */
+	*statistics = stage->statistics;
+	if (reset)
+	{
+		memset(&stage->statistics, 0, sizeof(stage->statistics));
+	}
+}
+
+uint8_t LP5024_InitShadow(lp5024_Shadow_t *shadow, lp5024_IdleMode_t idleMode, uint32_t idleTimeout)
+{
+	/* Checks for input errors. */
+	if (idleMode > LP5024_IdleChipDisable)
+	{
 		return LP5024_INPUTOUTOFRANGE;
 	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	memset(shadow, 0, sizeof(*shadow));
+	/* Register values after reset, see datasheet. */
+	shadow->reg[LP5024_REG_CONFIG] = 0x3C;
+	shadow->reg[LP5024_REG_BRIGHT_TOT] = 0xFF;
+	memset(&shadow->reg[LP5024_REG_BRIGHT_RGB_0], 0xFF, LP5024_RGBLED_COUNT);
+	shadow->idleMode = idleMode;
+	shadow->idleTimeout = idleTimeout;
+	shadow->lastActivity = LP5024_TIMESTAMP();
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_SyncShadow(lp5024_Device_t *device)
+{
+	if (LP5024_SHADOW(device) == NULL)
+	{ /* Checks for input errors, other parts have a different register layout. */
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	/* Reads all registers at once. */
+	return LP5024_ReadRegisters(device, LP5024_REG_ENABLE, device->shadow->reg, LP5024_REG_COUNT);
+}
+
+void LP5024_UpdateShadow(lp5024_Device_t *device, uint8_t regAdress, const uint8_t *data, uint16_t length)
+{
+	lp5024_Shadow_t *shadow = LP5024_SHADOW(device);
+	if (shadow == NULL)
 	{
-		/* Reads current setting of register. */
-		status = LP5024_ReadI2C(device, LP5024_REG_LED_CONF, &data);
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+		return;
 	}
-	/* Catches case when all attempts failed and returns last error code. */
-	if (status > HAL_OK)
+	for (uint16_t i = 0; i < length && regAdress + i < LP5024_REG_COUNT; i++)
 	{
-		return status;
+		shadow->reg[regAdress + i] = data[i];
 	}
-	/* Combines current value of register with value that has to be changed. */
-	data = (data & (~(0b1 << rgbLED))) | (active << rgbLED);
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	shadow->lastActivity = LP5024_TIMESTAMP();
+}
+
+void LP5024_GetPendingRegisters(lp5024_Device_t *device, uint8_t *reg)
+{
+	memcpy(reg, LP5024_SHADOW(device)->reg, LP5024_REG_COUNT);
+	for (uint8_t i = 0; i < LP5024_REG_COUNT && device->stage != NULL; i++)
 	{
-		/* Sends changed register settings to chip. */
-		status = LP5024_WriteI2C(device, LP5024_REG_LED_CONF, &data);
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
+		if (LP5024_STAGE_IS_MARKED(device->stage, i))
+		{ /* Staged value reaches the chip with the next commit. */
+			reg[i] = device->stage->reg[i];
 		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
 	}
-	return status;
 }
 
-uint8_t LP5024_SetTotalBrightness(lp5024_Device_t *device, uint8_t brightness)
+uint8_t LP5024_IsBlack(lp5024_Device_t *device)
+{
+	if (LP5024_SHADOW(device) == NULL)
+	{ /* Nothing known about the outputs. */
+		return 0;
+	}
+	const uint8_t *reg = LP5024_SHADOW(device)->reg;
+	uint8_t bankBlack = reg[LP5024_REG_BRIGHT_TOT] == 0 ||
+						(reg[LP5024_REG_BRIGHT_BANK_A] | reg[LP5024_REG_BRIGHT_BANK_B] | reg[LP5024_REG_BRIGHT_BANK_C]) == 0;
+	if (!(reg[LP5024_REG_ENABLE] & (0b1 << 6)) || (reg[LP5024_REG_CONFIG] & 0b1))
+	{ /* Disabled chip or global LED off. */
+		return 1;
+	}
+	for (uint8_t rgbLED = 0; rgbLED < LP5024_RGBLED_COUNT; rgbLED++)
+	{
+		if (reg[LP5024_REG_LED_CONF] & (0b1 << rgbLED))
+		{ /* LED follows bank colours. */
+			if (!bankBlack)
+			{
+				return 0;
+			}
+		}
+		else if (reg[LP5024_REG_BRIGHT_RGB_0 + rgbLED] != 0 &&
+				 (reg[LP5024_REG_BRIGHT_LED_0 + (rgbLED * 3)] | reg[LP5024_REG_BRIGHT_LED_1 + (rgbLED * 3)] |
+				  reg[LP5024_REG_BRIGHT_LED_2 + (rgbLED * 3)]) != 0)
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* Powers down idle device. Caller holds the lock. */
+static uint8_t LP5024_PowerDown(lp5024_Device_t *device)
 {
 	/* Holds i2c status for error catching. */
 	uint8_t status = 0;
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	lp5024_Shadow_t *shadow = LP5024_SHADOW(device);
+	uint8_t data = 0;
+	if (shadow == NULL || shadow->asleep || shadow->idleMode == LP5024_IdleStayOn ||
+		LP5024_TIMESTAMP() - shadow->lastActivity < shadow->idleTimeout || !LP5024_IsBlack(device))
+	{ /* Nothing to power down. */
+		return HAL_OK;
+	}
+	if (shadow->idleMode == LP5024_IdleChipDisable)
 	{
-		/* Sends changed register settings to chip. */
-		status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_TOT, &brightness);
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
+		if (shadow->reg[LP5024_REG_ENABLE] & (0b1 << 6))
+		{ /* Clears Chip_EN, shadow keeps the enabled state for the wake up. */
+			status = LP5024_Execute(device, LP5024_OperationWriteRaw, LP5024_REG_ENABLE, &data, 1);
+			shadow->powerTransactions++;
 		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+	}
+	else if (!(shadow->reg[LP5024_REG_CONFIG] & (0b1 << 4)))
+	{ /* Lets the chip save power on its own, shadow keeps the configured state. */
+		data = shadow->reg[LP5024_REG_CONFIG] | (0b1 << 4);
+		status = LP5024_Execute(device, LP5024_OperationWriteRaw, LP5024_REG_CONFIG, &data, 1);
+		shadow->powerTransactions++;
+	}
+	if (status == HAL_OK)
+	{
+		shadow->asleep = 1;
+		shadow->sleeps++;
 	}
 	return status;
 }
 
-uint8_t LP5024_SetRGBLEDBrightness(lp5024_Device_t *device, lp5024_RGBLEDs_t rgbLED, uint8_t brightness)
+uint8_t LP5024_IdleTick(lp5024_Device_t *device)
 {
 	/* Holds i2c status for error catching. */
 	uint8_t status = 0;
-	if (rgbLED > 7)
-	{ /* Checks for input errors. */
-		return LP5024_INPUTOUTOFRANGE;
-	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	LP5024_Lock(device);
+	status = LP5024_PowerDown(device);
+	LP5024_Unlock(device);
+	return status;
+}
+
+/* Restores all registers from the shadow, starting with Chip_EN, retry 0 for single attempts within the bus guard. Caller holds the lock. */
+static uint8_t LP5024_RestoreShadow(lp5024_Device_t *device, uint8_t retry)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = HAL_OK;
+	lp5024_Shadow_t *shadow = LP5024_SHADOW(device);
+	/* Without auto increment a burst lands in its first register. */
+	uint8_t length = (shadow->reg[LP5024_REG_CONFIG] & (0b1 << 3)) ? LP5024_REG_COUNT : 1;
+	for (uint8_t reg = LP5024_REG_ENABLE; reg < LP5024_REG_COUNT && status == HAL_OK; reg += length)
 	{
-		/* Sends changed register settings to chip. */
-		status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_RGB_0 + rgbLED, &brightness);
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+		status = retry ? LP5024_Execute(device, LP5024_OperationWriteRaw, reg, &shadow->reg[reg], length)
+					   : LP5024_WriteRawI2C(device, reg, &shadow->reg[reg], length);
 	}
 	return status;
 }
 
-uint8_t LP5024_SetIndividualLEDBrightness(lp5024_Device_t *device, lp5024_LEDs_t led, uint8_t brightness)
+/* Restores powered down device. Caller holds the lock. */
+static uint8_t LP5024_WakeDevice(lp5024_Device_t *device)
 {
 	/* Holds i2c status for error catching. */
 	uint8_t status = 0;
-	if (led > 23)
-	{ /* Checks for input errors. */
-		return LP5024_INPUTOUTOFRANGE;
+	lp5024_Shadow_t *shadow = LP5024_SHADOW(device);
+	uint32_t start = LP5024_TIMESTAMP();
+	if (shadow == NULL || !shadow->asleep)
+	{
+		return HAL_OK;
 	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	if (shadow->idleMode == LP5024_IdleChipDisable)
+	{ /* Chip_EN comes first, so the following registers reach an enabled chip. */
+		status = LP5024_RestoreShadow(device, 1);
+		shadow->powerTransactions++;
+	}
+	else if (!(shadow->reg[LP5024_REG_CONFIG] & (0b1 << 4)))
+	{ /* Restores configuration without power save. */
+		status = LP5024_Execute(device, LP5024_OperationWriteRaw, LP5024_REG_CONFIG, &shadow->reg[LP5024_REG_CONFIG], 1);
+		shadow->powerTransactions++;
+	}
+	if (status == HAL_OK)
 	{
-		/* Sends changed register settings to chip. */
-		status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_0 + led, &brightness);
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
+		uint32_t latency = LP5024_TIMESTAMP() - start;
+		shadow->asleep = 0;
+		shadow->lastActivity = LP5024_TIMESTAMP();
+		if (latency > shadow->wakeLatency)
+		{
+			shadow->wakeLatency = latency;
 		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
 	}
 	return status;
 }
 
-uint8_t LP5024_SetTotalColourHSB(lp5024_Device_t *device, uint8_t rgb, uint16_t hue, uint8_t saturation, uint8_t brightness)
+uint8_t LP5024_Wake(lp5024_Device_t *device)
 {
 	/* Holds i2c status for error catching. */
 	uint8_t status = 0;
-	uint8_t red = 0;
-	uint8_t green = 0;
-	uint8_t blue = 0;
-	/* Checks for input errors. */
-	if (hue >= 360 || saturation > 100 || brightness > 100)
+	LP5024_Lock(device);
+	status = LP5024_WakeDevice(device);
+	LP5024_Unlock(device);
+	return status;
+}
+
+void HSVtoRGB(uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t hue, uint8_t saturation, uint8_t brightness)
+{
+	float c, x, m;
+	m = brightness; // Cast brightness to float.
+	m /= 100;		// Normalise brightness.
+	c = saturation; // Cast saturation to float.
+	c /= 100;		// Normalise saturation.
+	c *= m;			// Calculates c (saturation * brightness).
+	m -= c;			// Calculates m (brightness - c).
+	x = hue;		// Cast hue to float.
+	/* Calculates x (c * (1 - |(hue/60) mod 2 -1|). */
+	x = c * (1 - abs(((int)(x / 60) % 2) - 1));
+	if (hue < 60)
 	{
-		return LP5024_INPUTOUTOFRANGE;
+		*red = (uint8_t)((c + m) * 255);
+		*green = (uint8_t)((x + m) * 255);
+		*blue = (uint8_t)(m * 255);
 	}
-	HSVtoRGB(&red, &green, &blue, hue, saturation, brightness);
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	else if (hue < 120)
 	{
-		/* Sends changed register settings to chip. */
-		if (rgb < 2)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_A, &red);
-		}
-		else if (rgb < 4)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_A, &green);
-		}
-		else
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_A, &blue);
-		}
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+		*red = (uint8_t)((x + m) * 255);
+		*green = (uint8_t)((c + m) * 255);
+		*blue = (uint8_t)(m * 255);
 	}
-	/* Catches case when all attempts failed and returns last error code. */
-	if (status > HAL_OK)
+	else if (hue < 180)
 	{
-		return status;
+		*red = (uint8_t)(m * 255);
+		*green = (uint8_t)((c + m) * 255);
+		*blue = (uint8_t)((x + m) * 255);
 	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	else if (hue < 240)
 	{
-		if (rgb == 0 || rgb == 4)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_B, &green);
-		}
-		else if (rgb == 1 || rgb == 3)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_B, &blue);
-		}
-		else
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_B, &red);
-		}
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+		*red = (uint8_t)(m * 255);
+		*green = (uint8_t)((x + m) * 255);
+		*blue = (uint8_t)((c + m) * 255);
 	}
-	/* Catches case when all attempts failed and returns last error code. */
-	if (status > HAL_OK)
+	else if (hue < 300)
 	{
-		return status;
+		*red = (uint8_t)((x + m) * 255);
+		*green = (uint8_t)(m * 255);
+		*blue = (uint8_t)((c + m) * 255);
 	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	else
 	{
-		if (rgb == 0 || rgb == 2)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_B, &blue);
-		}
-		else if (rgb == 3 || rgb == 4)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_B, &red);
-		}
-		else
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_B, &green);
-		}
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+		*red = (uint8_t)((c + m) * 255);
+		*green = (uint8_t)(m * 255);
+		*blue = (uint8_t)((x + m) * 255);
 	}
-	return status;
 }
 
-uint8_t LP5024_SetTotalColourRGB(lp5024_Device_t *device, uint8_t rgb, uint8_t red, uint8_t green, uint8_t blue)
+uint8_t LP5024_Enable(lp5024_Device_t *device, lp5024_Enable_t active)
 {
-	/* Holds i2c status for error catching. */
-	uint8_t status = 0;
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
-	{
-		if (rgb < 2)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_A, &red);
-		}
-		else if (rgb < 4)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_A, &green);
-		}
-		else
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_A, &blue);
-		}
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+	if (active > 1)
+	{ /* Checks for input errors. */
+		return LP5024_INPUTOUTOFRANGE;
 	}
-	/* Catches case when all attempts failed and returns last error code. */
-	if (status > HAL_OK)
-	{
-		return status;
+	/* Shifts bit in right position. */
+	uint8_t data = active << 6;
+	return LP5024_WriteRegisters(device, LP5024_PART(device)->regEnable, &data, 1);
+}
+
+uint8_t LP5024_SetLEDGlobalOff(lp5024_Device_t *device, lp5024_LED_OnOff_t active)
+{
+	if (active > 1)
+	{ /* Checks for input errors. */
+		return LP5024_INPUTOUTOFRANGE;
 	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
-	{
-		if (rgb == 0 || rgb == 4)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_B, &green);
-		}
-		else if (rgb == 1 || rgb == 3)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_B, &blue);
-		}
-		else
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_B, &red);
-		}
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+	return LP5024_ModifyRegister(device, LP5024_PART(device)->regConfig, 0b1, active);
+}
+
+uint8_t LP5024_SetMaxCurrent(lp5024_Device_t *device, lp5024_MaxCurrent_t current)
+{
+	if (current > 1)
+	{ /* Checks for input errors. */
+		return LP5024_INPUTOUTOFRANGE;
 	}
-	/* Catches case when all attempts failed and returns last error code. */
-	if (status > HAL_OK)
-	{
-		return status;
+	return LP5024_ModifyRegister(device, LP5024_PART(device)->regConfig, 0b1 << 1, current << 1);
+}
+
+uint8_t LP5024_SetPWMDithering(lp5024_Device_t *device, lp5024_PWMDithering_t active)
+{
+	if (active > 1)
+	{ /* Checks for input errors. */
+		return LP5024_INPUTOUTOFRANGE;
 	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
-	{
-		/* Sends changed register settings to chip. */
-		if (rgb == 0 || rgb == 2)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_C, &blue);
-		}
-		else if (rgb == 3 || rgb == 4)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_C, &red);
-		}
-		else
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_BANK_C, &green);
-		}
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+	return LP5024_ModifyRegister(device, LP5024_PART(device)->regConfig, 0b1 << 2, active << 2);
+}
+
+uint8_t LP5024_SetAutoIncrement(lp5024_Device_t *device, lp5024_AutoIncrement_t active)
+{
+	if (active > 1)
+	{ /* Checks for input errors. */
+		return LP5024_INPUTOUTOFRANGE;
 	}
-	return status;
+	return LP5024_ModifyRegister(device, LP5024_PART(device)->regConfig, 0b1 << 3, active << 3);
 }
 
-uint8_t LP5024_SetLEDColourHSB(lp5024_Device_t *device, uint8_t rgb, uint8_t rgbLED, uint16_t hue, uint8_t saturation, uint8_t brightness)
+uint8_t LP5024_SetAutoPowerSave(lp5024_Device_t *device, lp5024_PowerSave_t active)
+{
+	if (active > 1)
+	{ /* Checks for input errors. */
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	return LP5024_ModifyRegister(device, LP5024_PART(device)->regConfig, 0b1 << 4, active << 4);
+}
+
+uint8_t LP5024_SetLogScale(lp5024_Device_t *device, lp5024_LogScale_t active)
+{
+	if (active > 1)
+	{ /* Checks for input errors. */
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	return LP5024_ModifyRegister(device, LP5024_PART(device)->regConfig, 0b1 << 5, active << 5);
+}
+
+uint8_t LP5024_SetBankControl(lp5024_Device_t *device, lp5024_RGBLEDs_t rgbLED, lp5024_BankControl_t active)
+{
+	if (active > 1 || rgbLED >= LP5024_PART(device)->rgbLEDs)
+	{ /* Checks for input errors. */
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	/* Every LED configuration register holds 8 RGB LEDs. */
+	return LP5024_ModifyRegister(device, LP5024_PART(device)->regLEDConf + (rgbLED / 8), 0b1 << (rgbLED % 8), active << (rgbLED % 8));
+}
+
+uint8_t LP5024_SetTotalBrightness(lp5024_Device_t *device, uint8_t brightness)
+{
+	return LP5024_WriteRegisters(device, LP5024_PART(device)->regBankBrightness, &brightness, 1);
+}
+
+uint8_t LP5024_SetRGBLEDBrightness(lp5024_Device_t *device, lp5024_RGBLEDs_t rgbLED, uint8_t brightness)
+{
+	if (rgbLED >= LP5024_PART(device)->rgbLEDs)
+	{ /* Checks for input errors. */
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	return LP5024_WriteRegisters(device, LP5024_PART(device)->regRGBBrightness + rgbLED, &brightness, 1);
+}
+
+uint8_t LP5024_SetAllRGBLEDBrightness(lp5024_Device_t *device, const uint8_t *brightness)
+{
+	uint8_t data[LP5024_MAX_RGBLED_COUNT];
+	memcpy(data, brightness, LP5024_PART(device)->rgbLEDs);
+	/* Sends brightness of the whole chip in one burst. */
+	return LP5024_WriteRegisters(device, LP5024_PART(device)->regRGBBrightness, data, LP5024_PART(device)->rgbLEDs);
+}
+
+uint8_t LP5024_SetIndividualLEDBrightness(lp5024_Device_t *device, lp5024_LEDs_t led, uint8_t brightness)
+{
+	if (led >= LP5024_PART(device)->rgbLEDs * 3)
+	{ /* Checks for input errors. */
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	return LP5024_WriteRegisters(device, LP5024_PART(device)->regLED + led, &brightness, 1);
+}
+
+/* Writes one colour to three consecutive registers in the given colour order. */
+static uint8_t LP5024_WriteColour(lp5024_Device_t *device, uint8_t regAdress, uint8_t rgb, uint8_t red, uint8_t green, uint8_t blue)
 {
 	/* Holds i2c status for error catching. */
 	uint8_t status = 0;
+	uint8_t colour[3];
+	LP5024_PUT_RGB(colour, &LP5024_ChannelMaps[rgb], red, green, blue);
+	/* Single writes work with disabled auto increment as well. */
+	for (uint8_t channel = 0; channel < 3 && status == HAL_OK; channel++)
+	{
+		status = LP5024_WriteRegisters(device, regAdress + channel, &colour[channel], 1);
+	}
+	return status;
+}
+
+uint8_t LP5024_SetTotalColourHSB(lp5024_Device_t *device, uint8_t rgb, uint16_t hue, uint8_t saturation, uint8_t brightness)
+{
 	uint8_t red = 0;
 	uint8_t green = 0;
 	uint8_t blue = 0;
 	/* Checks for input errors. */
-	if (hue >= 360 || saturation > 100 || brightness > 100)
+	if (rgb > LP5024_BRG || hue >= 360 || saturation > 100 || brightness > 100)
 	{
 		return LP5024_INPUTOUTOFRANGE;
 	}
 	HSVtoRGB(&red, &green, &blue, hue, saturation, brightness);
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
-	{
-		if (rgb < 2)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_0 + (rgbLED * 3), &red);
-		}
-		else if (rgb < 4)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_0 + (rgbLED * 3), &green);
-		}
-		else
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_0 + (rgbLED * 3), &blue);
-		}
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
-	}
-	/* Catches case when all attempts failed and returns last error code. */
-	if (status > HAL_OK)
-	{
-		return status;
-	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	return LP5024_WriteColour(device, LP5024_PART(device)->regBankA, rgb, red, green, blue);
+}
+
+uint8_t LP5024_SetTotalColourRGB(lp5024_Device_t *device, uint8_t rgb, uint8_t red, uint8_t green, uint8_t blue)
+{
+	/* Checks for input errors. */
+	if (rgb > LP5024_BRG)
 	{
-		if (rgb == 0 || rgb == 4)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_1 + (rgbLED * 3), &green);
-		}
-		else if (rgb == 1 || rgb == 3)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_1 + (rgbLED * 3), &blue);
-		}
-		else
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_1 + (rgbLED * 3), &red);
-		}
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+		return LP5024_INPUTOUTOFRANGE;
 	}
-	/* Catches case when all attempts failed and returns last error code. */
-	if (status > HAL_OK)
+	return LP5024_WriteColour(device, LP5024_PART(device)->regBankA, rgb, red, green, blue);
+}
+
+uint8_t LP5024_SetLEDColourHSB(lp5024_Device_t *device, uint8_t rgb, uint8_t rgbLED, uint16_t hue, uint8_t saturation, uint8_t brightness)
+{
+	uint8_t red = 0;
+	uint8_t green = 0;
+	uint8_t blue = 0;
+	/* Checks for input errors. */
+	if (rgb > LP5024_BRG || rgbLED >= LP5024_PART(device)->rgbLEDs || hue >= 360 || saturation > 100 || brightness > 100)
 	{
-		return status;
+		return LP5024_INPUTOUTOFRANGE;
 	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	HSVtoRGB(&red, &green, &blue, hue, saturation, brightness);
+	return LP5024_WriteColour(device, LP5024_PART(device)->regLED + (rgbLED * 3), rgb, red, green, blue);
+}
+
+uint8_t LP5024_SetLEDHueSaturation(lp5024_Device_t *device, uint8_t rgb, uint8_t rgbLED, uint16_t hue, uint8_t saturation)
+{
+	uint8_t red = 0;
+	uint8_t green = 0;
+	uint8_t blue = 0;
+	/* Checks for input errors. */
+	if (rgb > LP5024_BRG || rgbLED >= LP5024_PART(device)->rgbLEDs || hue >= 360 || saturation > 100)
 	{
-		if (rgb == 0 || rgb == 2)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_2 + (rgbLED * 3), &blue);
-		}
-		else if (rgb == 3 || rgb == 4)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_2 + (rgbLED * 3), &red);
-		}
-		else
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_2 + (rgbLED * 3), &green);
-		}
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+		return LP5024_INPUTOUTOFRANGE;
 	}
-	return status;
+	/* Full brightness, so the RGB LED brightness register alone sets the intensity. */
+	HSVtoRGB(&red, &green, &blue, hue, saturation, 100);
+	return LP5024_WriteColour(device, LP5024_PART(device)->regLED + (rgbLED * 3), rgb, red, green, blue);
 }
 
 uint8_t LP5024_SetLEDColourRGB(lp5024_Device_t *device, uint8_t rgb, uint8_t rgbLED, uint8_t red, uint8_t green, uint8_t blue)
 {
-	/* Holds i2c status for error catching. */
-	uint8_t status = 0;
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
-	{
-		if (rgb < 2)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_0 + (rgbLED * 3), &red);
-		}
-		else if (rgb < 4)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_0 + (rgbLED * 3), &green);
-		}
-		else
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_0 + (rgbLED * 3), &blue);
-		}
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
-	}
-	/* Catches case when all attempts failed and returns last error code. */
-	if (status > HAL_OK)
-	{
-		return status;
-	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	/* Checks for input errors. */
+	if (rgb > LP5024_BRG || rgbLED >= LP5024_PART(device)->rgbLEDs)
 	{
-		if (rgb == 0 || rgb == 4)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_1 + (rgbLED * 3), &green);
-		}
-		else if (rgb == 1 || rgb == 3)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_1 + (rgbLED * 3), &blue);
-		}
-		else
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_1 + (rgbLED * 3), &red);
-		}
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+		return LP5024_INPUTOUTOFRANGE;
 	}
-	/* Catches case when all attempts failed and returns last error code. */
-	if (status > HAL_OK)
+	return LP5024_WriteColour(device, LP5024_PART(device)->regLED + (rgbLED * 3), rgb, red, green, blue);
+}
+
+uint8_t LP5024_SetLEDColoursRGB(lp5024_Device_t *device, uint8_t rgb, uint8_t firstLED, uint8_t count, const uint8_t *colours)
+{
+	uint8_t data[LP5024_MAX_LED_COUNT];
+	/* Checks for input errors. */
+	if (rgb > LP5024_BRG || count == 0 || firstLED + count > LP5024_PART(device)->rgbLEDs)
 	{
-		return status;
+		return LP5024_INPUTOUTOFRANGE;
 	}
-	/* Repeats i2c call, in case of busy i2c unit. */
-	for (uint8_t attempt = 0; attempt <= LP5024_I2C_MAX_ATTEMPTS; attempt++)
+	const lp5024_ChannelMap_t *map = &LP5024_ChannelMaps[rgb];
+	for (uint8_t led = 0; led < count; led++)
 	{
-		if (rgb == 0 || rgb == 2)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_2 + (rgbLED * 3), &blue);
-		}
-		else if (rgb == 3 || rgb == 4)
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_2 + (rgbLED * 3), &red);
-		}
-		else
-		{ /* Sends changed register settings to chip. */
-			status = LP5024_WriteI2C(device, LP5024_REG_BRIGHT_LED_2 + (rgbLED * 3), &green);
-		}
-		if (status == HAL_OK)
-		{ /* Breaks out of loop if successful. */
-			break;
-		}
-		else if (status == HAL_ERROR)
-		{ /* Returns error if i2c unit fails. */
-			return HAL_ERROR;
-		}
-		/* Delays next i2c call if first attempt failed. */
-		HAL_Delay(LP5024_I2C_ATTEMPT_DELAY);
+		LP5024_PUT_RGB(&data[led * 3], map, colours[led * 3], colours[(led * 3) + 1], colours[(led * 3) + 2]);
 	}
-	return status;
+	/* Sends all LEDs in one burst. */
+	return LP5024_WriteRegisters(device, LP5024_PART(device)->regLED + (firstLED * 3), data, count * 3);
 }
 
 /**
@@ -0,0 +1,146 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Canvas.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Virtual LED canvas spanning many Texas Instruments LP5024 LED driver ICs.
+ * @date 	Dec 7, 2023
+ ******************************************************************************
+ */
+
+/** @addtogroup IC_Drivers
+ * @{
+ */
+
+/** @addtogroup LED_Driver
+ * @{
+ */
+
+#include "LP5024_Canvas.h"
+#include <string.h> // For initialisation.
+
+uint8_t LP5024_Canvas_MapRun(lp5024_CanvasMap_t *map, lp5024_Handle_t handle, uint8_t firstLED, uint8_t count, uint8_t rgb, uint8_t reverse)
+{
+	/* Checks for input errors. */
+	if (rgb > LP5024_BRG || firstLED >= LP5024_RGBLED_COUNT || (!reverse && firstLED + count > LP5024_RGBLED_COUNT) || (reverse && count > firstLED + 1))
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	for (uint8_t entry = 0; entry < count; entry++)
+	{
+		map[entry].handle = handle;
+		map[entry].rgbLED = reverse ? firstLED - entry : firstLED + entry;
+		map[entry].rgb = rgb;
+	}
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Canvas_Init(lp5024_Canvas_t *canvas, lp5024_DeviceTable_t *table, const lp5024_CanvasMap_t *map, uint16_t count)
+{
+	/* Checks for input errors. */
+	if (count > LP5024_CANVAS_MAX_LEDS)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	for (uint16_t index = 0; index < count; index++)
+	{
+		if (map[index].handle >= table->count || map[index].rgbLED >= LP5024_RGBLED_COUNT || map[index].rgb > LP5024_BRG)
+		{
+			return LP5024_INPUTOUTOFRANGE;
+		}
+	}
+	memset(canvas, 0, sizeof(*canvas));
+	canvas->table = table;
+	canvas->count = count;
+	/* Resolves map once, OUTx images of the table are contiguous. */
+	for (uint16_t index = 0; index < count; index++)
+	{
+		canvas->offset[index] = (map[index].handle * LP5024_LED_COUNT) + (map[index].rgbLED * 3);
+		canvas->handle[index] = map[index].handle;
+		canvas->rgb[index] = map[index].rgb;
+	}
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Canvas_SetLED(lp5024_Canvas_t *canvas, uint16_t index, uint8_t red, uint8_t green, uint8_t blue)
+{
+	/* Checks for input errors. */
+	if (index >= canvas->count)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	uint8_t colour[3] = {red, green, blue};
+	return LP5024_Canvas_Write(canvas, index, 1, colour);
+}
+
+uint8_t LP5024_Canvas_Write(lp5024_Canvas_t *canvas, uint16_t first, uint16_t count, const uint8_t *colours)
+{
+	/* Checks for input errors. */
+	if (first + count > canvas->count)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	uint32_t cycles = LP5024_CYCLES();
+	lp5024_DeviceTable_t *table = canvas->table;
+	uint8_t *frames = table->frame[0];
+	/* Collects touched chips locally, the table is marked once per chip. */
+	uint32_t touched[(LP5024_TABLE_MAX_DEVICES + 31) / 32] = {0};
+	for (uint16_t index = first; index < first + count; index++)
+	{
+		uint8_t *led = &frames[canvas->offset[index]];
+		LP5024_PUT_RGB(led, &LP5024_ChannelMaps[canvas->rgb[index]], colours[0], colours[1], colours[2]);
+		LP5024_MASK_MARK(touched, canvas->handle[index]);
+		colours += 3;
+	}
+	for (uint16_t handle = 0; handle < table->count; handle++)
+	{
+		if (LP5024_MASK_IS_MARKED(touched, handle))
+		{
+			LP5024_Table_MarkDirty(table, handle);
+		}
+	}
+	canvas->statistics.cycles += LP5024_CYCLES() - cycles;
+	canvas->statistics.leds += count;
+	canvas->statistics.updates++;
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Canvas_Flush(lp5024_Canvas_t *canvas)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = HAL_OK;
+	lp5024_DeviceTable_t *table = canvas->table;
+	for (uint16_t handle = 0; handle < table->count; handle++)
+	{
+		if (!LP5024_Table_IsDirty(table, handle))
+		{ /* Skips unchanged chips. */
+			continue;
+		}
+		uint8_t result = LP5024_Table_Flush(table, handle, 1);
+		if (result != HAL_OK)
+		{ /* Chip stays marked for the next flush, chips on other buses are still sent. */
+			status = (status == HAL_OK) ? result : status;
+			continue;
+		}
+		canvas->statistics.transactions++;
+		canvas->statistics.bytes += LP5024_LED_COUNT;
+	}
+	return status;
+}
+
+void LP5024_Canvas_GetStats(lp5024_Canvas_t *canvas, lp5024_CanvasStats_t *statistics, uint8_t reset)
+{
+	*statistics = canvas->statistics;
+	if (reset)
+	{
+		memset(&canvas->statistics, 0, sizeof(canvas->statistics));
+	}
+}
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,179 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Compositor.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Layer compositor of Texas Instruments LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ ******************************************************************************
+ */
+
+/** @addtogroup IC_Drivers
+ * @{
+ */
+
+/** @addtogroup LED_Driver
+ * @{
+ */
+
+#include "LP5024_Compositor.h"
+#include <string.h> // For initialisation.
+
+/* Blends colour over base, exact rounded division by 255 without divide instruction. */
+static inline uint8_t LP5024_Compositor_Mix(uint8_t base, uint8_t colour, uint8_t alpha)
+{
+	uint32_t sum = ((uint32_t)base * (255 - alpha)) + ((uint32_t)colour * alpha) + 128;
+	return (uint8_t)((sum + (sum >> 8)) >> 8);
+}
+
+uint8_t LP5024_Compositor_Init(lp5024_Compositor_t *compositor, lp5024_Device_t *device, uint8_t rgb)
+{
+	/* Checks for input errors, layers are flushed to the OUTx registers of LP5018 and LP5024. */
+	if (rgb > LP5024_BRG || !LP5024_NATIVE_LAYOUT(device))
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	memset(compositor, 0, sizeof(*compositor));
+	compositor->device = device;
+	compositor->map = &LP5024_ChannelMaps[rgb];
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Compositor_SetLED(lp5024_Compositor_t *compositor, uint8_t layer, uint8_t rgbLED, uint8_t red, uint8_t green, uint8_t blue, uint8_t alpha)
+{
+	/* Checks for input errors. */
+	if (layer >= LP5024_COMPOSITOR_LAYERS || rgbLED >= LP5024_RGBLED_COUNT)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	lp5024_Layer_t *target = &compositor->layers[layer];
+	uint8_t *colour = target->colour[rgbLED];
+	if (colour[0] != red || colour[1] != green || colour[2] != blue || target->alpha[rgbLED] != alpha)
+	{
+		colour[0] = red;
+		colour[1] = green;
+		colour[2] = blue;
+		target->alpha[rgbLED] = alpha;
+		compositor->dirty |= 1UL << rgbLED;
+	}
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Compositor_SetAlpha(lp5024_Compositor_t *compositor, uint8_t layer, uint8_t rgbLED, uint8_t alpha)
+{
+	/* Checks for input errors. */
+	if (layer >= LP5024_COMPOSITOR_LAYERS || rgbLED >= LP5024_RGBLED_COUNT)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	if (compositor->layers[layer].alpha[rgbLED] != alpha)
+	{
+		compositor->layers[layer].alpha[rgbLED] = alpha;
+		compositor->dirty |= 1UL << rgbLED;
+	}
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Compositor_ClearLayer(lp5024_Compositor_t *compositor, uint8_t layer)
+{
+	/* Checks for input errors. */
+	if (layer >= LP5024_COMPOSITOR_LAYERS)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	for (uint8_t rgbLED = 0; rgbLED < LP5024_RGBLED_COUNT; rgbLED++)
+	{
+		LP5024_Compositor_SetAlpha(compositor, layer, rgbLED, 0);
+	}
+	return LP5024_SUCCESS;
+}
+
+uint32_t LP5024_Compositor_Blend(lp5024_Compositor_t *compositor)
+{
+	uint32_t changed = 0;
+	uint32_t cycles = LP5024_CYCLES();
+	const lp5024_ChannelMap_t *map = compositor->map;
+	for (uint8_t rgbLED = 0; rgbLED < LP5024_RGBLED_COUNT; rgbLED++)
+	{
+		if (!(compositor->dirty & (1UL << rgbLED)))
+		{ /* Inputs unchanged, image keeps its result. */
+			continue;
+		}
+		uint8_t red = 0, green = 0, blue = 0;
+		for (uint8_t layer = 0; layer < LP5024_COMPOSITOR_LAYERS; layer++)
+		{
+			const lp5024_Layer_t *source = &compositor->layers[layer];
+			uint8_t alpha = source->alpha[rgbLED];
+			if (alpha == 0)
+			{ /* Transparent, nothing to mix. */
+				continue;
+			}
+			red = LP5024_Compositor_Mix(red, source->colour[rgbLED][0], alpha);
+			green = LP5024_Compositor_Mix(green, source->colour[rgbLED][1], alpha);
+			blue = LP5024_Compositor_Mix(blue, source->colour[rgbLED][2], alpha);
+		}
+		uint8_t *led = &compositor->image[rgbLED * 3];
+		if (led[map->red] != red || led[map->green] != green || led[map->blue] != blue)
+		{
+			LP5024_PUT_RGB(led, map, red, green, blue);
+			changed |= 1UL << rgbLED;
+		}
+		compositor->statistics.blended++;
+	}
+	compositor->dirty = 0;
+	/* Flush sends everything blended since the last successful flush. */
+	compositor->unsent |= changed;
+	compositor->statistics.cycles += LP5024_CYCLES() - cycles;
+	return changed;
+}
+
+uint8_t LP5024_Compositor_Flush(lp5024_Compositor_t *compositor)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = HAL_OK;
+	/* Includes LEDs blended by the application and LEDs of a failed flush. */
+	LP5024_Compositor_Blend(compositor);
+	uint32_t changed = compositor->unsent;
+	uint8_t first = 0, last = LP5024_RGBLED_COUNT - 1;
+	compositor->statistics.frames++;
+	if (changed == 0)
+	{ /* Nothing visible changed. */
+		return HAL_OK;
+	}
+	while (!(changed & (1UL << first)))
+	{
+		first++;
+	}
+	while (!(changed & (1UL << last)))
+	{
+		last--;
+	}
+	/* One burst from first to last changed LED, unchanged LEDs in between cost less than a new transaction. */
+	uint16_t length = (last - first + 1) * 3;
+	status = LP5024_WriteRegisters(compositor->device, LP5024_REG_BRIGHT_LED_0 + (first * 3), &compositor->image[first * 3], length);
+	if (status != HAL_OK)
+	{
+		return status;
+	}
+	compositor->unsent = 0;
+	compositor->statistics.transactions++;
+	compositor->statistics.bytes += length;
+	return status;
+}
+
+void LP5024_Compositor_GetStats(lp5024_Compositor_t *compositor, lp5024_CompositorStats_t *statistics, uint8_t reset)
+{
+	*statistics = compositor->statistics;
+	if (reset)
+	{
+		memset(&compositor->statistics, 0, sizeof(compositor->statistics));
+	}
+}
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,68 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Dither.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Temporal dithering for Texas Instruments LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ ******************************************************************************
+ */
+
+/** @addtogroup IC_Drivers
+ * @{
+ */
+
+/** @addtogroup LED_Driver
+ * @{
+ */
+
+#include "LP5024_Dither.h"
+#include <string.h> // For initialisation.
+
+void LP5024_Dither_Init(lp5024_Dither_t *dither, lp5024_Pipeline_t *pipeline)
+{
+	memset(dither, 0, sizeof(*dither));
+	dither->pipeline = pipeline;
+}
+
+uint8_t LP5024_Dither_SetLEDColourRGB(lp5024_Dither_t *dither, uint8_t rgbLED, uint16_t red, uint16_t green, uint16_t blue)
+{
+	/* Checks for input errors. */
+	if (rgbLED >= LP5024_RGBLED_COUNT)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	LP5024_PUT_RGB(&dither->value[rgbLED * 3], LP5024_Pipeline_GetChannelMap(dither->pipeline), red, green, blue);
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Dither_Render(lp5024_Dither_t *dither)
+{
+	uint8_t *frame = LP5024_Pipeline_GetFrame(dither->pipeline);
+	if (frame == NULL)
+	{ /* Keeps accumulators, a frame that is not sent must not count. */
+		return HAL_BUSY;
+	}
+	for (uint8_t led = 0; led < LP5024_LED_COUNT; led++)
+	{
+		uint16_t sum = (dither->value[led] & 0xFF) + dither->error[led];
+		uint16_t out = (dither->value[led] >> 8) + (sum >> 8);
+		if (out > 0xFF)
+		{ /* Full scale can not be raised, fraction stays in the accumulator. */
+			out = 0xFF;
+			sum = 0xFF;
+		}
+		frame[led] = (uint8_t)out;
+		dither->error[led] = (uint8_t)sum;
+	}
+	dither->frames++;
+	return LP5024_Pipeline_Submit(dither->pipeline);
+}
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,218 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Effect.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Procedural effects of Texas Instruments LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ ******************************************************************************
+ */
+
+/** @addtogroup IC_Drivers
+ * @{
+ */
+
+/** @addtogroup LED_Driver
+ * @{
+ */
+
+#include "LP5024_Effect.h"
+#include <string.h> // For initialisation.
+
+/* First quarter of 127 * sin(x), x = 0 to pi / 2. */
+static const uint8_t LP5024_Effect_QuarterSine[65] = {
+	0, 3, 6, 9, 12, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+	49, 51, 54, 57, 60, 63, 65, 68, 71, 73, 76, 78, 81, 83, 85, 88,
+	90, 92, 94, 96, 98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+	117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+	127};
+
+/* Returns sine of a 1/256 turn angle, 0 to 255, rising through 128 at angle 0. */
+static inline uint8_t LP5024_Effect_Sine(uint8_t angle)
+{
+	uint8_t index = angle & 0x3F;
+	uint8_t value = (angle & 0x40) ? LP5024_Effect_QuarterSine[64 - index] : LP5024_Effect_QuarterSine[index];
+	return (angle & 0x80) ? 127 - value : 128 + value;
+}
+
+/* Returns waveform of a 1/256 turn angle, 0 at angle 0, peak at half turn. */
+static inline uint8_t LP5024_Effect_Wave(uint8_t wave, uint8_t angle)
+{
+	if (wave == LP5024_WaveTriangle)
+	{
+		return (angle & 0x80) ? (uint8_t)((255 - angle) << 1) : (uint8_t)(angle << 1);
+	}
+	/* Quarter turn back puts the trough of the sine at angle 0. */
+	return LP5024_Effect_Sine(angle - 64);
+}
+
+/* Scales value by level, exact at level 0 and 255. */
+static inline uint8_t LP5024_Effect_Scale(uint8_t value, uint8_t level)
+{
+	return (uint8_t)(((uint16_t)value * (level + 1)) >> 8);
+}
+
+/* Steps 16 bit Galois LFSR with maximum period. */
+static inline uint16_t LP5024_Effect_Random(uint16_t lfsr)
+{
+	return (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+}
+
+/* Sets up fields shared by all effects. */
+static uint8_t LP5024_Effect_Init(lp5024_Effect_t *effect, lp5024_EffectType_t type, uint8_t red, uint8_t green, uint8_t blue, uint32_t period)
+{
+	/* Checks for input errors. */
+	if (period == 0)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	memset(effect, 0, sizeof(*effect));
+	effect->type = type;
+	effect->colour[0] = red;
+	effect->colour[1] = green;
+	effect->colour[2] = blue;
+	effect->increment = UINT32_MAX / period;
+	effect->last = LP5024_TIMESTAMP();
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Effect_InitBreathe(lp5024_Effect_t *effect, uint8_t red, uint8_t green, uint8_t blue, uint32_t period, lp5024_Wave_t wave, uint8_t spread)
+{
+	/* Checks for input errors. */
+	if (wave > LP5024_WaveTriangle)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	uint8_t status = LP5024_Effect_Init(effect, LP5024_EffectBreathe, red, green, blue, period);
+	effect->wave = wave;
+	effect->spread = spread;
+	return status;
+}
+
+uint8_t LP5024_Effect_InitChase(lp5024_Effect_t *effect, uint8_t red, uint8_t green, uint8_t blue, uint32_t period, uint8_t width)
+{
+	/* Checks for input errors. */
+	if (width == 0)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	uint8_t status = LP5024_Effect_Init(effect, LP5024_EffectChase, red, green, blue, period);
+	effect->width = width;
+	return status;
+}
+
+uint8_t LP5024_Effect_InitSparkle(lp5024_Effect_t *effect, uint8_t red, uint8_t green, uint8_t blue, uint8_t density, uint8_t decay, uint16_t seed)
+{
+	/* Checks for input errors, zero would lock the LFSR. */
+	if (seed == 0)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	/* Sparkles run per tick, the period only keeps the phase defined. */
+	uint8_t status = LP5024_Effect_Init(effect, LP5024_EffectSparkle, red, green, blue, UINT32_MAX);
+	effect->density = density;
+	effect->decay = decay;
+	effect->lfsr = seed;
+	return status;
+}
+
+uint8_t LP5024_Effect_InitStrobe(lp5024_Effect_t *effect, uint8_t red, uint8_t green, uint8_t blue, uint32_t period, uint8_t duty)
+{
+	uint8_t status = LP5024_Effect_Init(effect, LP5024_EffectStrobe, red, green, blue, period);
+	effect->duty = duty;
+	return status;
+}
+
+uint8_t LP5024_Effect_Tick(lp5024_Effect_t *effect, uint8_t *image, uint16_t count, uint8_t rgb)
+{
+	/* Checks for input errors. */
+	if (rgb > LP5024_BRG || effect->type > LP5024_EffectStrobe)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	uint32_t cycles = LP5024_CYCLES();
+	const lp5024_ChannelMap_t *map = &LP5024_ChannelMaps[rgb];
+	const uint8_t *colour = effect->colour;
+	uint32_t now = LP5024_TIMESTAMP();
+	/* Unsigned arithmetic wraps phase and timestamp alike. */
+	effect->phase += (now - effect->last) * effect->increment;
+	effect->last = now;
+	uint8_t angle = effect->phase >> 24;
+	switch (effect->type)
+	{
+	case LP5024_EffectBreathe:
+		for (uint16_t led = 0; led < count; led++)
+		{
+			uint8_t level = LP5024_Effect_Wave(effect->wave, angle);
+			LP5024_PUT_RGB(&image[led * 3], map, LP5024_Effect_Scale(colour[0], level), LP5024_Effect_Scale(colour[1], level), LP5024_Effect_Scale(colour[2], level));
+			angle += effect->spread;
+		}
+		break;
+	case LP5024_EffectChase:
+	{
+		uint16_t head = ((uint64_t)effect->phase * count) >> 32;
+		/* One division per tick, tail fades linearly over width LEDs. */
+		uint16_t step = 256 / effect->width;
+		for (uint16_t led = 0; led < count; led++)
+		{
+			uint16_t distance = (head >= led) ? head - led : head + count - led;
+			uint8_t level = (distance < effect->width) ? 255 - (distance * step) : 0;
+			LP5024_PUT_RGB(&image[led * 3], map, LP5024_Effect_Scale(colour[0], level), LP5024_Effect_Scale(colour[1], level), LP5024_Effect_Scale(colour[2], level));
+		}
+		break;
+	}
+	case LP5024_EffectSparkle:
+	{
+		uint8_t keep = 255 - effect->decay;
+		uint16_t lfsr = effect->lfsr;
+		for (uint16_t led = 0; led < count; led++)
+		{
+			uint8_t *out = &image[led * 3];
+			lfsr = LP5024_Effect_Random(lfsr);
+			if ((uint8_t)lfsr < effect->density)
+			{
+				LP5024_PUT_RGB(out, map, colour[0], colour[1], colour[2]);
+			}
+			else
+			{ /* Decays values of the last tick in place, order of colours does not matter. */
+				out[0] = LP5024_Effect_Scale(out[0], keep);
+				out[1] = LP5024_Effect_Scale(out[1], keep);
+				out[2] = LP5024_Effect_Scale(out[2], keep);
+			}
+		}
+		effect->lfsr = lfsr;
+		break;
+	}
+	case LP5024_EffectStrobe:
+	{
+		uint8_t on = angle < effect->duty;
+		uint8_t red = on ? colour[0] : 0, green = on ? colour[1] : 0, blue = on ? colour[2] : 0;
+		for (uint16_t led = 0; led < count; led++)
+		{
+			LP5024_PUT_RGB(&image[led * 3], map, red, green, blue);
+		}
+		break;
+	}
+	}
+	effect->statistics.cycles += LP5024_CYCLES() - cycles;
+	effect->statistics.leds += count;
+	effect->statistics.ticks++;
+	return LP5024_SUCCESS;
+}
+
+void LP5024_Effect_GetStats(lp5024_Effect_t *effect, lp5024_EffectStats_t *statistics, uint8_t reset)
+{
+	*statistics = effect->statistics;
+	if (reset)
+	{
+		memset(&effect->statistics, 0, sizeof(effect->statistics));
+	}
+}
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,128 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Gradient.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Gradient rendering for Texas Instruments LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ ******************************************************************************
+ */
+
+/** @addtogroup IC_Drivers
+ * @{
+ */
+
+/** @addtogroup LED_Driver
+ * @{
+ */
+
+#include "LP5024_Gradient.h"
+
+#define LP5024_GRADIENT_HUE_Q8 ((uint32_t)LP5024_GRADIENT_HUE_STEPS << 8) ///< Full circle in 8 bit fixed point.
+
+/* Applies saturation and brightness to a fully saturated channel. */
+static inline uint8_t LP5024_Gradient_Shade(uint8_t channel, uint16_t saturation, uint16_t brightness)
+{
+	return (uint8_t)(((255 - (((255 - channel) * saturation) >> 8)) * brightness) >> 8);
+}
+
+uint8_t LP5024_Gradient_Rainbow(uint8_t *frame, const lp5024_ChannelMap_t *map, uint16_t count, uint16_t hue, uint16_t span, uint8_t saturation, uint8_t brightness)
+{
+	/* Checks for input errors. */
+	if (hue >= 360 || saturation > 100 || brightness > 100)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	if (count == 0)
+	{
+		return LP5024_SUCCESS;
+	}
+	/* Converts degrees to the internal hue circle once per call. */
+	uint32_t position = ((uint32_t)hue * LP5024_GRADIENT_HUE_Q8) / 360;
+	uint32_t step = (uint32_t)((((uint64_t)span * LP5024_GRADIENT_HUE_Q8) / 360 / count) % LP5024_GRADIENT_HUE_Q8);
+	/* Scales are off by one, so 100 % keeps the channel unchanged. */
+	uint16_t s = (((uint16_t)saturation * 255 + 50) / 100) + 1;
+	uint16_t b = (((uint16_t)brightness * 255 + 50) / 100) + 1;
+	for (uint16_t led = 0; led < count; led++)
+	{
+		uint8_t rising = (position >> 8) & 0xFF;
+		uint8_t falling = 255 - rising;
+		uint8_t red, green, blue;
+		switch (position >> 16)
+		{
+		case 0:
+			red = 255, green = rising, blue = 0;
+			break;
+		case 1:
+			red = falling, green = 255, blue = 0;
+			break;
+		case 2:
+			red = 0, green = 255, blue = rising;
+			break;
+		case 3:
+			red = 0, green = falling, blue = 255;
+			break;
+		case 4:
+			red = rising, green = 0, blue = 255;
+			break;
+		default:
+			red = 255, green = 0, blue = falling;
+			break;
+		}
+		LP5024_PUT_RGB(&frame[led * 3], map, LP5024_Gradient_Shade(red, s, b), LP5024_Gradient_Shade(green, s, b), LP5024_Gradient_Shade(blue, s, b));
+		/* Steps to the neighbour, wraps around the hue circle. */
+		position += step;
+		if (position >= LP5024_GRADIENT_HUE_Q8)
+		{
+			position -= LP5024_GRADIENT_HUE_Q8;
+		}
+	}
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Gradient_Linear(uint8_t *frame, const lp5024_ChannelMap_t *map, uint16_t count, uint16_t offset, const uint8_t *stops, uint8_t stopCount)
+{
+	/* Checks for input errors. */
+	if (stopCount < 2 || count < stopCount)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	uint16_t led = offset % count;
+	uint16_t done = 0;
+	for (uint8_t segment = 0; segment < stopCount - 1; segment++)
+	{
+		const uint8_t *from = &stops[segment * 3];
+		const uint8_t *to = from + 3;
+		/* Splits LEDs evenly, last segment also ends on its stop. */
+		uint16_t end = (uint16_t)(((uint32_t)(count - 1) * (segment + 1)) / (stopCount - 1));
+		uint16_t length = end - done;
+		int32_t value[3];
+		int32_t step[3];
+		for (uint8_t channel = 0; channel < 3; channel++)
+		{ /* 16 bit fixed point, stepping keeps rounding errors below one LED. */
+			value[channel] = ((int32_t)from[channel] << 16) + 0x8000;
+			step[channel] = (((int32_t)to[channel] - from[channel]) * 65536) / (length > 0 ? length : 1);
+		}
+		uint16_t last = segment == stopCount - 2 ? end + 1 : end;
+		for (; done < last; done++)
+		{
+			LP5024_PUT_RGB(&frame[led * 3], map, value[0] >> 16, value[1] >> 16, value[2] >> 16);
+			value[0] += step[0];
+			value[1] += step[1];
+			value[2] += step[2];
+			if (++led == count)
+			{
+				led = 0;
+			}
+		}
+	}
+	return LP5024_SUCCESS;
+}
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
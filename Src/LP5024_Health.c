@@ -0,0 +1,152 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Health.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   State verification of Texas Instruments LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ ******************************************************************************
+ */
+
+/** @addtogroup IC_Drivers
+ * @{
+ */
+
+/** @addtogroup LED_Driver
+ * @{
+ */
+
+#include "LP5024_Health.h"
+#include <string.h> // For initialisation.
+
+/* Returns bus time of one transaction in us. */
+static uint32_t LP5024_Health_Cost(lp5024_Health_t *health, uint32_t overhead, uint16_t length)
+{
+	uint32_t bits = overhead + (9 * (uint32_t)length);
+	return (uint32_t)(((uint64_t)bits * 1000000) / health->busSpeed);
+}
+
+/* Returns bus time of reading or writing the whole register file in us, one transaction per register without auto increment. */
+static uint32_t LP5024_Health_FileCost(lp5024_Health_t *health, uint32_t overhead, uint8_t single)
+{
+	if (single)
+	{
+		return LP5024_REG_COUNT * LP5024_Health_Cost(health, overhead, 1);
+	}
+	return LP5024_Health_Cost(health, overhead, LP5024_REG_COUNT);
+}
+
+/* Grants bus time elapsed since last tick, limited to one check with complete repair. */
+static void LP5024_Health_Grant(lp5024_Health_t *health, uint8_t single)
+{
+	uint32_t now = LP5024_TIMESTAMP();
+	int32_t limit = LP5024_Health_FileCost(health, LP5024_HEALTH_READ_OVERHEAD_BITS, single) +
+					LP5024_Health_FileCost(health, LP5024_HEALTH_WRITE_OVERHEAD_BITS, single);
+	uint64_t grant = ((uint64_t)(now - health->lastTick) * 1000000 * health->budget) / (100 * (uint64_t)LP5024_TIMESTAMP_HZ);
+	health->lastTick = now;
+	if (grant >= (uint64_t)limit || health->credit + (int32_t)grant > limit)
+	{
+		health->credit = limit;
+	}
+	else
+	{
+		health->credit += (int32_t)grant;
+	}
+}
+
+uint8_t LP5024_Health_Init(lp5024_Health_t *health, lp5024_Device_t *device, uint32_t busSpeed, uint8_t budget)
+{
+	/* Checks for input errors. */
+	if (LP5024_SHADOW(device) == NULL || busSpeed == 0 || budget == 0 || budget > 100)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	memset(health, 0, sizeof(*health));
+	health->device = device;
+	health->busSpeed = busSpeed;
+	health->budget = budget;
+	health->lastTick = LP5024_TIMESTAMP();
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Health_Tick(lp5024_Health_t *health)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = HAL_OK;
+	lp5024_Shadow_t *shadow = LP5024_SHADOW(health->device);
+	uint8_t chip[LP5024_REG_COUNT];
+	/* Without auto increment a burst reads or writes its first register only. */
+	uint8_t single = !(shadow->reg[LP5024_REG_CONFIG] & (0b1 << 3));
+	uint32_t cost = LP5024_Health_FileCost(health, LP5024_HEALTH_READ_OVERHEAD_BITS, single);
+	LP5024_Health_Grant(health, single);
+	if (shadow->asleep || health->credit < (int32_t)cost || HAL_I2C_GetState(health->device->hi2c) != HAL_I2C_STATE_READY)
+	{ /* Waits for budget and idle bus, powered down chips differ from the shadow on purpose. */
+		return HAL_BUSY;
+	}
+	/* Keeps other clients off the bus between read back and repair. */
+	LP5024_Lock(health->device);
+	/* Reads whole register file at once or register by register. */
+	for (uint8_t reg = 0; reg < LP5024_REG_COUNT && status == HAL_OK; reg += single ? 1 : LP5024_REG_COUNT)
+	{
+		status = LP5024_ReadBurstI2C(health->device, reg, &chip[reg], single ? 1 : LP5024_REG_COUNT);
+	}
+	health->credit -= cost;
+	if (status != HAL_OK)
+	{
+		LP5024_Unlock(health->device);
+		health->statistics.failures++;
+		return status;
+	}
+	for (uint8_t reg = 0; reg < LP5024_REG_COUNT; reg++)
+	{
+		if (chip[reg] == shadow->reg[reg])
+		{
+			continue;
+		}
+		/* Extends span over following mismatches, as long as the gap is cheaper than a new burst. */
+		uint8_t end = reg;
+		for (uint8_t next = reg + 1; next < LP5024_REG_COUNT && next - end <= LP5024_HEALTH_MERGE_GAP + 1 && !single; next++)
+		{
+			if (chip[next] != shadow->reg[next])
+			{
+				health->statistics.mismatches++;
+				end = next;
+			}
+		}
+		health->statistics.mismatches++;
+		/* A span starting at ENABLE sets Chip_EN before the following registers. */
+		status = LP5024_WriteBurstI2C(health->device, reg, &shadow->reg[reg], end - reg + 1);
+		uint32_t repair = LP5024_Health_Cost(health, LP5024_HEALTH_WRITE_OVERHEAD_BITS, end - reg + 1);
+		cost += repair;
+		health->credit -= repair;
+		if (status != HAL_OK)
+		{ /* Remaining spans are repaired by the next check. */
+			health->statistics.failures++;
+			break;
+		}
+		health->statistics.repairs++;
+		reg = end;
+	}
+	LP5024_Unlock(health->device);
+	health->statistics.checks++;
+	health->statistics.lastCost = cost;
+	health->statistics.totalCost += cost;
+	return status;
+}
+
+void LP5024_Health_GetStats(lp5024_Health_t *health, lp5024_HealthStats_t *statistics, uint8_t reset)
+{
+	*statistics = health->statistics;
+	if (reset)
+	{
+		memset(&health->statistics, 0, sizeof(health->statistics));
+	}
+}
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
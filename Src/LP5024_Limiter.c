@@ -0,0 +1,177 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Limiter.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Supply current limiter of many Texas Instruments LP5024 LED driver ICs.
+ * @date 	Dec 7, 2023
+ ******************************************************************************
+ */
+
+/** @addtogroup IC_Drivers
+ * @{
+ */
+
+/** @addtogroup LED_Driver
+ * @{
+ */
+
+#include "LP5024_Limiter.h"
+#include <string.h> // For initialisation and comparison.
+
+#define LP5024_LIMITER_BANK (LP5024_RGBLED_COUNT) ///< Index of bank brightness within request and applied values.
+
+/* Returns output current of a chip with rgbLEDs RGB LEDs in uA for the given RGBx and bank brightness. */
+static uint32_t LP5024_Limiter_Current(const uint8_t *reg, const uint8_t *brightness, uint8_t rgbLEDs)
+{
+	/* Sum of colour code times brightness code of all outputs. */
+	uint32_t duty = 0;
+	uint32_t bankColour = reg[LP5024_REG_BRIGHT_BANK_A] + reg[LP5024_REG_BRIGHT_BANK_B] + reg[LP5024_REG_BRIGHT_BANK_C];
+	if (!(reg[LP5024_REG_ENABLE] & (0b1 << 6)) || (reg[LP5024_REG_CONFIG] & 0b1))
+	{ /* Disabled chip or global LED off. */
+		return 0;
+	}
+	for (uint8_t rgbLED = 0; rgbLED < rgbLEDs; rgbLED++)
+	{
+		if (reg[LP5024_REG_LED_CONF] & (0b1 << rgbLED))
+		{ /* LED follows bank colours. */
+			duty += bankColour * brightness[LP5024_LIMITER_BANK];
+		}
+		else
+		{
+			const uint8_t *led = &reg[LP5024_REG_BRIGHT_LED_0 + (rgbLED * 3)];
+			duty += (uint32_t)(led[0] + led[1] + led[2]) * brightness[rgbLED];
+		}
+	}
+	uint32_t fullScale = (reg[LP5024_REG_CONFIG] & (0b1 << 1)) ? LP5024_LIMITER_CURRENT_35MA : LP5024_LIMITER_CURRENT_26MA;
+	return (uint32_t)(((uint64_t)fullScale * duty) / (255 * 255));
+}
+
+uint8_t LP5024_Limiter_Init(lp5024_Limiter_t *limiter, uint32_t budget)
+{
+	memset(limiter, 0, sizeof(*limiter));
+	limiter->budget = budget;
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Limiter_Add(lp5024_Limiter_t *limiter, lp5024_Device_t *device)
+{
+	/* Checks for input errors, estimate relies on the LP5018 and LP5024 register layout. */
+	if (limiter->count >= LP5024_LIMITER_MAX_DEVICES || LP5024_SHADOW(device) == NULL)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	uint8_t chip = limiter->count++;
+	uint8_t reg[LP5024_REG_COUNT];
+	LP5024_GetPendingRegisters(device, reg);
+	limiter->devices[chip] = device;
+	memcpy(limiter->requested[chip], &reg[LP5024_REG_BRIGHT_RGB_0], LP5024_RGBLED_COUNT);
+	limiter->requested[chip][LP5024_LIMITER_BANK] = reg[LP5024_REG_BRIGHT_TOT];
+	memcpy(limiter->applied[chip], limiter->requested[chip], sizeof(limiter->applied[chip]));
+	return LP5024_SUCCESS;
+}
+
+uint32_t LP5024_Limiter_Estimate(lp5024_Device_t *device)
+{
+	if (LP5024_SHADOW(device) == NULL)
+	{ /* Nothing known about the chip. */
+		return 0;
+	}
+	uint8_t reg[LP5024_REG_COUNT];
+	uint8_t brightness[LP5024_RGBLED_COUNT + 1];
+	LP5024_GetPendingRegisters(device, reg);
+	memcpy(brightness, &reg[LP5024_REG_BRIGHT_RGB_0], LP5024_RGBLED_COUNT);
+	brightness[LP5024_LIMITER_BANK] = reg[LP5024_REG_BRIGHT_TOT];
+	return LP5024_Limiter_Current(reg, brightness, LP5024_PART(device)->rgbLEDs);
+}
+
+uint8_t LP5024_Limiter_Apply(lp5024_Limiter_t *limiter)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = HAL_OK;
+	uint64_t estimate = 0;
+	/* Scale factor in Q16. */
+	uint32_t scale = 1UL << 16;
+	/* Register values of the next frame, so an open scope is limited before it reaches the chip. */
+	uint8_t reg[LP5024_REG_COUNT];
+	for (uint8_t chip = 0; chip < limiter->count; chip++)
+	{
+		LP5024_GetPendingRegisters(limiter->devices[chip], reg);
+		for (uint8_t i = 0; i <= LP5024_LIMITER_BANK; i++)
+		{
+			uint8_t value = reg[i < LP5024_LIMITER_BANK ? LP5024_REG_BRIGHT_RGB_0 + i : LP5024_REG_BRIGHT_TOT];
+			if (value != limiter->applied[chip][i])
+			{ /* Application wrote new brightness since the last frame. */
+				limiter->requested[chip][i] = value;
+				limiter->applied[chip][i] = value;
+			}
+		}
+		estimate += LP5024_Limiter_Current(reg, limiter->requested[chip], LP5024_PART(limiter->devices[chip])->rgbLEDs);
+	}
+	if (estimate > limiter->budget)
+	{
+		scale = (uint32_t)(((uint64_t)limiter->budget << 16) / estimate);
+		limiter->statistics.limited++;
+	}
+	for (uint8_t chip = 0; chip < limiter->count; chip++)
+	{
+		lp5024_Device_t *device = limiter->devices[chip];
+		/* LED configuration bits of the RGB LEDs the part has. */
+		uint8_t leds = (uint8_t)((1U << LP5024_PART(device)->rgbLEDs) - 1);
+		uint8_t target[LP5024_RGBLED_COUNT + 1];
+		LP5024_GetPendingRegisters(device, reg);
+		for (uint8_t i = 0; i <= LP5024_LIMITER_BANK; i++)
+		{ /* Rounds down, so the limited current stays within the budget. */
+			target[i] = (uint8_t)(((uint32_t)limiter->requested[chip][i] * scale) >> 16);
+		}
+		if ((reg[LP5024_REG_LED_CONF] & leds) != leds && memcmp(target, &reg[LP5024_REG_BRIGHT_RGB_0], LP5024_RGBLED_COUNT) != 0)
+		{ /* LEDs in individual mode are scaled by their RGBx brightness in one burst. */
+			uint8_t result = LP5024_WriteRegisters(device, LP5024_REG_BRIGHT_RGB_0, target, LP5024_RGBLED_COUNT);
+			limiter->statistics.writes++;
+			if (result != HAL_OK)
+			{
+				limiter->statistics.failures++;
+				status = result;
+			}
+		}
+		if ((reg[LP5024_REG_LED_CONF] & leds) != 0 && target[LP5024_LIMITER_BANK] != reg[LP5024_REG_BRIGHT_TOT])
+		{ /* LEDs in bank mode are scaled by the single bank brightness register. */
+			uint8_t result = LP5024_WriteRegisters(device, LP5024_REG_BRIGHT_TOT, &target[LP5024_LIMITER_BANK], 1);
+			limiter->statistics.writes++;
+			if (result != HAL_OK)
+			{
+				limiter->statistics.failures++;
+				status = result;
+			}
+		}
+		/* Registers not written keep their value, so they are no new request. */
+		LP5024_GetPendingRegisters(device, reg);
+		memcpy(limiter->applied[chip], &reg[LP5024_REG_BRIGHT_RGB_0], LP5024_RGBLED_COUNT);
+		limiter->applied[chip][LP5024_LIMITER_BANK] = reg[LP5024_REG_BRIGHT_TOT];
+	}
+	limiter->statistics.frames++;
+	limiter->statistics.estimate = (uint32_t)estimate;
+	limiter->statistics.current = (uint32_t)((estimate * scale) >> 16);
+	if (limiter->statistics.estimate > limiter->statistics.peak)
+	{
+		limiter->statistics.peak = limiter->statistics.estimate;
+	}
+	return status;
+}
+
+void LP5024_Limiter_GetStats(lp5024_Limiter_t *limiter, lp5024_LimiterStats_t *statistics, uint8_t reset)
+{
+	*statistics = limiter->statistics;
+	if (reset)
+	{
+		memset(&limiter->statistics, 0, sizeof(limiter->statistics));
+	}
+}
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
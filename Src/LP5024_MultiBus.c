@@ -0,0 +1,166 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_MultiBus.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Parallel frame flush of LP5024 on several I2C units.
+ * @date 	Dec 7, 2023
+ ******************************************************************************
+ */
+
+/** @addtogroup IC_Drivers
+ * @{
+ */
+
+/** @addtogroup LED_Driver
+ * @{
+ */
+
+#include "LP5024_MultiBus.h"
+#include <string.h> // For initialisation.
+
+/* Starts next pipeline of a lane, marks lane idle when all devices are done. */
+static void LP5024_MultiBus_Advance(lp5024_MultiBus_t *multiBus, lp5024_BusLane_t *lane)
+{
+	while (lane->next < lane->count)
+	{
+		if (LP5024_Pipeline_Submit(multiBus->pipelines[lane->first + lane->next]) == HAL_OK)
+		{ /* Completion callback continues with the next device. */
+			return;
+		}
+		/* Skips device that could not be started. */
+		multiBus->errors++;
+		lane->next++;
+	}
+	lane->ticks = LP5024_TIMESTAMP() - multiBus->flushStart;
+	if (--multiBus->active == 0)
+	{
+		multiBus->flushTicks = LP5024_TIMESTAMP() - multiBus->flushStart;
+	}
+}
+
+/* Finds lane of an I2C handler. */
+static lp5024_BusLane_t *LP5024_MultiBus_FindLane(lp5024_MultiBus_t *multiBus, I2C_HandleTypeDef *hi2c)
+{
+	for (uint8_t lane = 0; lane < multiBus->laneCount; lane++)
+	{
+		if (multiBus->lanes[lane].hi2c == hi2c)
+		{
+			return &multiBus->lanes[lane];
+		}
+	}
+	return NULL;
+}
+
+uint8_t LP5024_MultiBus_Init(lp5024_MultiBus_t *multiBus, lp5024_Pipeline_t **pipelines, uint8_t count)
+{
+	uint8_t sorted = 0;
+	/* Checks for input errors. */
+	if (count > LP5024_MULTIBUS_MAX_DEVICES)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	memset(multiBus, 0, sizeof(*multiBus));
+	for (uint8_t device = 0; device < count; device++)
+	{
+		I2C_HandleTypeDef *hi2c = pipelines[device]->device->hi2c;
+		if (LP5024_MultiBus_FindLane(multiBus, hi2c) != NULL)
+		{ /* Bus already collected by an earlier device. */
+			continue;
+		}
+		if (multiBus->laneCount >= LP5024_MULTIBUS_MAX_BUSES)
+		{
+			return LP5024_INPUTOUTOFRANGE;
+		}
+		lp5024_BusLane_t *lane = &multiBus->lanes[multiBus->laneCount++];
+		lane->hi2c = hi2c;
+		lane->first = sorted;
+		/* Collects all devices of this bus in their original order. */
+		for (uint8_t other = device; other < count; other++)
+		{
+			if (pipelines[other]->device->hi2c == hi2c)
+			{
+				multiBus->pipelines[sorted++] = pipelines[other];
+				lane->count++;
+			}
+		}
+	}
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_MultiBus_Flush(lp5024_MultiBus_t *multiBus)
+{
+	if (multiBus->active)
+	{
+		return HAL_BUSY;
+	}
+	/* Locks all frames first, so no device is rendered while its bus mates transmit. */
+	for (uint8_t lane = 0; lane < multiBus->laneCount; lane++)
+	{
+		for (uint8_t device = 0; device < multiBus->lanes[lane].count; device++)
+		{
+			if (LP5024_Pipeline_Queue(multiBus->pipelines[multiBus->lanes[lane].first + device]) != HAL_OK)
+			{
+				multiBus->errors++;
+			}
+		}
+	}
+	multiBus->flushStart = LP5024_TIMESTAMP();
+	multiBus->active = multiBus->laneCount;
+	/* Starts all buses before the first completion can arrive. */
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	for (uint8_t lane = 0; lane < multiBus->laneCount; lane++)
+	{
+		multiBus->lanes[lane].next = 0;
+		LP5024_MultiBus_Advance(multiBus, &multiBus->lanes[lane]);
+	}
+	__set_PRIMASK(primask);
+	return HAL_OK;
+}
+
+uint8_t LP5024_MultiBus_IsDone(lp5024_MultiBus_t *multiBus)
+{
+	return multiBus->active == 0;
+}
+
+void LP5024_MultiBus_TxCpltCallback(lp5024_MultiBus_t *multiBus, I2C_HandleTypeDef *hi2c)
+{
+	lp5024_BusLane_t *lane = LP5024_MultiBus_FindLane(multiBus, hi2c);
+	if (lane == NULL || lane->next >= lane->count)
+	{ /* Ignores transfers of other drivers. */
+		return;
+	}
+	LP5024_Pipeline_TxCpltCallback(multiBus->pipelines[lane->first + lane->next], hi2c);
+	if (multiBus->pipelines[lane->first + lane->next]->busy)
+	{ /* Device continues with further chunks or urgent writes. */
+		return;
+	}
+	lane->next++;
+	LP5024_MultiBus_Advance(multiBus, lane);
+}
+
+void LP5024_MultiBus_ErrorCallback(lp5024_MultiBus_t *multiBus, I2C_HandleTypeDef *hi2c)
+{
+	lp5024_BusLane_t *lane = LP5024_MultiBus_FindLane(multiBus, hi2c);
+	if (lane == NULL || lane->next >= lane->count)
+	{ /* Ignores transfers of other drivers. */
+		return;
+	}
+	LP5024_Pipeline_ErrorCallback(multiBus->pipelines[lane->first + lane->next], hi2c);
+	multiBus->errors++;
+	if (multiBus->pipelines[lane->first + lane->next]->busy)
+	{ /* Device continues with further chunks or urgent writes. */
+		return;
+	}
+	lane->next++;
+	LP5024_MultiBus_Advance(multiBus, lane);
+}
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,145 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Palette.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Palette indexed framebuffer of many Texas Instruments LP5024 LED driver ICs.
+ * @date 	Dec 7, 2023
+ ******************************************************************************
+ */
+
+/** @addtogroup IC_Drivers
+ * @{
+ */
+
+/** @addtogroup LED_Driver
+ * @{
+ */
+
+#include "LP5024_Palette.h"
+#include <string.h> // For initialisation.
+
+/* Checks palette entry, 8 bit indices can not exceed the palette. */
+#if LP5024_PALETTE_BITS == 4
+#define LP5024_PALETTE_IS_ENTRY(entry) ((entry) < LP5024_PALETTE_SIZE)
+#else
+#define LP5024_PALETTE_IS_ENTRY(entry) (1)
+#endif
+
+/* Returns palette index of an LED. */
+static inline uint8_t LP5024_Palette_GetIndex(const uint8_t *index, uint8_t rgbLED)
+{
+#if LP5024_PALETTE_BITS == 4
+	return (index[rgbLED >> 1] >> ((rgbLED & 1) * 4)) & 0x0F;
+#else
+	return index[rgbLED];
+#endif
+}
+
+void LP5024_Palette_Init(lp5024_PaletteBuffer_t *buffer)
+{
+	memset(buffer, 0, sizeof(*buffer));
+}
+
+uint8_t LP5024_Palette_Add(lp5024_PaletteBuffer_t *buffer, I2C_HandleTypeDef *hi2c, lp5024_A0_t a0, uint8_t rgb, const lp5024_Palette_t *palette, uint8_t *handle)
+{
+	/* Checks for input errors. */
+	if (buffer->count >= LP5024_PALETTE_MAX_DEVICES || a0 > LP5024_A1_VDD_A0_VDD || rgb > LP5024_BRG || palette == NULL)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	*handle = buffer->count++;
+	buffer->hi2c[*handle] = hi2c;
+	buffer->a0[*handle] = a0;
+	buffer->rgb[*handle] = rgb;
+	buffer->palette[*handle] = palette;
+	memset(buffer->index[*handle], 0, LP5024_PALETTE_INDEX_BYTES);
+	LP5024_MASK_MARK(buffer->dirty, *handle);
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Palette_SetLED(lp5024_PaletteBuffer_t *buffer, uint8_t handle, uint8_t rgbLED, uint8_t entry)
+{
+	/* Checks for input errors. */
+	if (handle >= buffer->count || rgbLED >= LP5024_RGBLED_COUNT || !LP5024_PALETTE_IS_ENTRY(entry))
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+#if LP5024_PALETTE_BITS == 4
+	uint8_t *byte = &buffer->index[handle][rgbLED >> 1];
+	uint8_t shift = (rgbLED & 1) * 4;
+	*byte = (*byte & ~(0x0F << shift)) | (entry << shift);
+#else
+	buffer->index[handle][rgbLED] = entry;
+#endif
+	LP5024_MASK_MARK(buffer->dirty, handle);
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Palette_SetEntry(lp5024_PaletteBuffer_t *buffer, lp5024_Palette_t *palette, uint8_t entry, uint8_t red, uint8_t green, uint8_t blue)
+{
+	/* Checks for input errors. */
+	if (!LP5024_PALETTE_IS_ENTRY(entry))
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	palette->colour[entry][0] = red;
+	palette->colour[entry][1] = green;
+	palette->colour[entry][2] = blue;
+	for (uint16_t handle = 0; handle < buffer->count; handle++)
+	{
+		if (buffer->palette[handle] != palette || LP5024_MASK_IS_MARKED(buffer->dirty, handle))
+		{
+			continue;
+		}
+		for (uint8_t rgbLED = 0; rgbLED < LP5024_RGBLED_COUNT; rgbLED++)
+		{
+			if (LP5024_Palette_GetIndex(buffer->index[handle], rgbLED) == entry)
+			{ /* Chip shows the changed entry. */
+				LP5024_MASK_MARK(buffer->dirty, handle);
+				break;
+			}
+		}
+	}
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Palette_Flush(lp5024_PaletteBuffer_t *buffer)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = 0;
+	/* Register image of the chip currently flushed, on the stack so flushes of several buffers may overlap. */
+	uint8_t image[LP5024_LED_COUNT];
+	for (uint16_t handle = 0; handle < buffer->count; handle++)
+	{
+		if (!LP5024_MASK_IS_MARKED(buffer->dirty, handle))
+		{ /* Skips unchanged chips. */
+			continue;
+		}
+		uint32_t cycles = LP5024_CYCLES();
+		const lp5024_ChannelMap_t *map = &LP5024_ChannelMaps[buffer->rgb[handle]];
+		for (uint8_t rgbLED = 0; rgbLED < LP5024_RGBLED_COUNT; rgbLED++)
+		{
+			const uint8_t *colour = buffer->palette[handle]->colour[LP5024_Palette_GetIndex(buffer->index[handle], rgbLED)];
+			LP5024_PUT_RGB(&image[rgbLED * 3], map, colour[0], colour[1], colour[2]);
+		}
+		buffer->cycles += LP5024_CYCLES() - cycles;
+		buffer->expanded++;
+		lp5024_Device_t device = {buffer->hi2c[handle], buffer->a0[handle], NULL, NULL, NULL, NULL};
+		status = LP5024_WriteRegisters(&device, LP5024_REG_BRIGHT_LED_0, image, LP5024_LED_COUNT);
+		if (status > HAL_OK)
+		{ /* Keeps chip marked, so next flush retries. */
+			return status;
+		}
+		LP5024_MASK_CLEAR(buffer->dirty, handle);
+	}
+	return status;
+}
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
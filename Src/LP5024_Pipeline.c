@@ -0,0 +1,499 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Pipeline.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Pipelined frame output for Texas Instruments LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ ******************************************************************************
+ */
+
+/** @addtogroup IC_Drivers
+ * @{
+ */
+
+/** @addtogroup LED_Driver
+ * @{
+ */
+
+#include "LP5024_Pipeline.h"
+#include <string.h> // For buffer initialisation.
+
+/* Issues one transaction, data points behind the register address for the transmit backend. */
+static uint8_t LP5024_Pipeline_Transmit(lp5024_Pipeline_t *pipeline, uint8_t regAdress, uint8_t *data, uint8_t length)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = 0;
+	pipeline->busy = 1;
+	pipeline->transferStart = LP5024_TIMESTAMP();
+#if LP5024_PIPELINE_USE_TRANSMIT
+	/* Register address already sits in front of data. */
+	(void)regAdress;
+#endif
+#if LP5024_PIPELINE_USE_TRANSMIT && LP5024_PIPELINE_USE_DMA
+	status = HAL_I2C_Master_Transmit_DMA(pipeline->device->hi2c, LP5024_I2C_ADDRESS(pipeline->device), data - 1, length + 1);
+#elif LP5024_PIPELINE_USE_TRANSMIT
+	status = HAL_I2C_Master_Transmit_IT(pipeline->device->hi2c, LP5024_I2C_ADDRESS(pipeline->device), data - 1, length + 1);
+#elif LP5024_PIPELINE_USE_DMA
+	status = HAL_I2C_Mem_Write_DMA(pipeline->device->hi2c, LP5024_I2C_ADDRESS(pipeline->device), regAdress,
+								   I2C_MEMADD_SIZE_8BIT, data, length);
+#else
+	status = HAL_I2C_Mem_Write_IT(pipeline->device->hi2c, LP5024_I2C_ADDRESS(pipeline->device), regAdress,
+								  I2C_MEMADD_SIZE_8BIT, data, length);
+#endif
+	if (status != HAL_OK)
+	{
+		pipeline->busy = 0;
+	}
+	return status;
+}
+
+/* Checks if the next transaction shows content on a powered down chip. */
+static uint8_t LP5024_Pipeline_NeedsWake(lp5024_Pipeline_t *pipeline)
+{
+	const lp5024_Shadow_t *shadow = LP5024_SHADOW(pipeline->device);
+	const uint8_t *frame = NULL;
+	uint8_t length = 0;
+	if (shadow == NULL || !shadow->asleep)
+	{
+		return 0;
+	}
+	if (pipeline->queueCount > 0)
+	{
+		const lp5024_UrgentWrite_t *write = &pipeline->queue[pipeline->queueHead];
+		return write->data[0] < LP5024_REG_BRIGHT_TOT || write->data[1] != 0;
+	}
+	if (pipeline->sending)
+	{
+		frame = &pipeline->buffer[pipeline->transmit][LP5024_PIPELINE_HEADER + pipeline->offset];
+		length = LP5024_LED_COUNT - pipeline->offset;
+	}
+	else if (pipeline->pending)
+	{
+		frame = &pipeline->buffer[pipeline->render][LP5024_PIPELINE_HEADER];
+		length = LP5024_LED_COUNT;
+	}
+	for (uint8_t led = 0; led < length; led++)
+	{ /* Black content does not need a lit device. */
+		if (frame[led] != 0)
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/* Marks chip awake once its registers are restored. */
+static void LP5024_Pipeline_EndWake(lp5024_Pipeline_t *pipeline)
+{
+	lp5024_Shadow_t *shadow = LP5024_SHADOW(pipeline->device);
+	uint32_t latency = LP5024_TIMESTAMP() - pipeline->wakeStart;
+	pipeline->wakeEnd = 0;
+	shadow->asleep = 0;
+	shadow->lastActivity = LP5024_TIMESTAMP();
+	if (latency > shadow->wakeLatency)
+	{
+		shadow->wakeLatency = latency;
+	}
+}
+
+/* Prepares wake up of a powered down chip from a copy of its shadow, like LP5024_Wake. Caller masks interrupts. */
+static void LP5024_Pipeline_StartWake(lp5024_Pipeline_t *pipeline)
+{
+	const lp5024_Shadow_t *shadow = LP5024_SHADOW(pipeline->device);
+	memcpy(&pipeline->wake[LP5024_PIPELINE_HEADER], shadow->reg, LP5024_REG_COUNT);
+	pipeline->wakeStart = LP5024_TIMESTAMP();
+	if (shadow->idleMode == LP5024_IdleChipDisable)
+	{ /* Chip_EN comes first, so the following registers reach an enabled chip. */
+		pipeline->wakeReg = LP5024_REG_ENABLE;
+		pipeline->wakeEnd = LP5024_REG_COUNT;
+	}
+	else if (!(shadow->reg[LP5024_REG_CONFIG] & (0b1 << 4)))
+	{ /* Restores configuration without power save. */
+		pipeline->wakeReg = LP5024_REG_CONFIG;
+		pipeline->wakeEnd = LP5024_REG_CONFIG + 1;
+	}
+	else
+	{ /* Power save is configured anyway, nothing to restore. */
+		LP5024_Pipeline_EndWake(pipeline);
+	}
+}
+
+/* Sends next part of the wake up, one register per transaction without auto increment. Caller masks interrupts. */
+static uint8_t LP5024_Pipeline_Wake(lp5024_Pipeline_t *pipeline)
+{
+	uint8_t *data = &pipeline->wake[LP5024_PIPELINE_HEADER + pipeline->wakeReg];
+	pipeline->length = 1;
+	if (pipeline->wake[LP5024_PIPELINE_HEADER + LP5024_REG_CONFIG] & (0b1 << 3))
+	{ /* Chip keeps its configuration while powered down, so auto increment spreads the burst. */
+		pipeline->length = pipeline->wakeEnd - pipeline->wakeReg;
+	}
+#if LP5024_PIPELINE_HEADER
+	/* Byte in front of the registers is already sent or the header, it takes the register address. */
+	data[-1] = pipeline->wakeReg;
+#endif
+	return LP5024_Pipeline_Transmit(pipeline, pipeline->wakeReg, data, pipeline->length);
+}
+
+/* Starts next transaction: wake up of the chip, urgent writes, then the frame on the bus, then a pending frame. Caller masks interrupts. */
+static uint8_t LP5024_Pipeline_Next(lp5024_Pipeline_t *pipeline)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = HAL_OK;
+	if (pipeline->wakeEnd == 0 && LP5024_Pipeline_NeedsWake(pipeline))
+	{
+		LP5024_Pipeline_StartWake(pipeline);
+	}
+	if (pipeline->wakeEnd != 0)
+	{ /* Wake up goes ahead of the transaction that needs it. */
+		return LP5024_Pipeline_Wake(pipeline);
+	}
+	if (pipeline->queueCount > 0)
+	{
+		lp5024_UrgentWrite_t *write = &pipeline->queue[pipeline->queueHead];
+		pipeline->urgent = 1;
+		status = LP5024_Pipeline_Transmit(pipeline, write->data[0], &write->data[1], 1);
+		if (status != HAL_OK)
+		{
+			pipeline->urgent = 0;
+		}
+		return status;
+	}
+	if (!pipeline->sending)
+	{
+		if (!pipeline->pending)
+		{ /* Nothing to send. */
+			return HAL_OK;
+		}
+		/* Takes rendered frame to the bus and hands the previous one to the application, it already holds the latest state. */
+		pipeline->transmit = pipeline->render;
+		pipeline->render = pipeline->transmit ^ 1;
+		pipeline->pending = 0;
+		pipeline->sending = 1;
+		pipeline->offset = 0;
+		memcpy(pipeline->buffer[pipeline->render], pipeline->buffer[pipeline->transmit], sizeof(pipeline->buffer[0]));
+		LP5024_NotifyTransfer(pipeline->device, LP5024_LED_COUNT);
+	}
+	uint8_t *chunk = &pipeline->buffer[pipeline->transmit][LP5024_PIPELINE_HEADER + pipeline->offset];
+	pipeline->length = LP5024_LED_COUNT - pipeline->offset;
+	if (pipeline->length > LP5024_PIPELINE_CHUNK_SIZE)
+	{
+		pipeline->length = LP5024_PIPELINE_CHUNK_SIZE;
+	}
+#if LP5024_PIPELINE_HEADER
+	if (pipeline->offset > 0)
+	{ /* Borrows the already sent byte in front of the chunk for its register address. */
+		pipeline->saved = chunk[-1];
+		chunk[-1] = LP5024_REG_BRIGHT_LED_0 + pipeline->offset;
+	}
+#endif
+	status = LP5024_Pipeline_Transmit(pipeline, LP5024_REG_BRIGHT_LED_0 + pipeline->offset, chunk, pipeline->length);
+#if LP5024_PIPELINE_HEADER
+	if (status != HAL_OK && pipeline->offset > 0)
+	{
+		chunk[-1] = pipeline->saved;
+	}
+#endif
+	return status;
+}
+
+/* Finishes the current transaction. */
+static void LP5024_Pipeline_Finish(lp5024_Pipeline_t *pipeline, uint8_t success)
+{
+	uint32_t now = LP5024_TIMESTAMP();
+	pipeline->busTicks += now - pipeline->transferStart;
+	pipeline->busy = 0;
+	if (pipeline->wakeEnd != 0)
+	{
+		LP5024_SHADOW(pipeline->device)->powerTransactions++;
+		if (!success)
+		{ /* Drops the transaction waiting for the chip, like a failed one, the next one wakes it again. */
+			pipeline->wakeEnd = 0;
+			if (pipeline->queueCount > 0)
+			{
+				pipeline->queueHead = (pipeline->queueHead + 1) % LP5024_PIPELINE_URGENT_SLOTS;
+				pipeline->queueCount--;
+			}
+			else if (pipeline->sending)
+			{
+				pipeline->sending = 0;
+			}
+			else
+			{
+				pipeline->pending = 0;
+			}
+			return;
+		}
+		pipeline->wakeReg += pipeline->length;
+		if (pipeline->wakeReg >= pipeline->wakeEnd)
+		{
+			LP5024_Pipeline_EndWake(pipeline);
+		}
+		return;
+	}
+	if (pipeline->urgent)
+	{ /* Removes urgent write from queue, also on failure to not block the queue. */
+		if (success)
+		{
+			uint32_t latency = now - pipeline->queue[pipeline->queueHead].timestamp;
+			LP5024_UpdateShadow(pipeline->device, pipeline->queue[pipeline->queueHead].data[0], &pipeline->queue[pipeline->queueHead].data[1], 1);
+			pipeline->statistics.urgentWrites++;
+			if (latency > pipeline->statistics.urgentLatency)
+			{
+				pipeline->statistics.urgentLatency = latency;
+			}
+		}
+		pipeline->urgent = 0;
+		pipeline->queueHead = (pipeline->queueHead + 1) % LP5024_PIPELINE_URGENT_SLOTS;
+		pipeline->queueCount--;
+		return;
+	}
+#if LP5024_PIPELINE_HEADER
+	if (pipeline->offset > 0)
+	{ /* Restores frame byte borrowed for the register address. */
+		pipeline->buffer[pipeline->transmit][LP5024_PIPELINE_HEADER + pipeline->offset - 1] = pipeline->saved;
+	}
+#endif
+	if (success)
+	{
+		LP5024_UpdateShadow(pipeline->device, LP5024_REG_BRIGHT_LED_0 + pipeline->offset,
+							&pipeline->buffer[pipeline->transmit][LP5024_PIPELINE_HEADER + pipeline->offset], pipeline->length);
+	}
+	pipeline->offset += pipeline->length;
+	if (!success || pipeline->offset >= LP5024_LED_COUNT)
+	{ /* Frame is done, a failed frame is dropped. */
+		pipeline->sending = 0;
+		if (success)
+		{
+			pipeline->statistics.frames++;
+			if (!pipeline->pending)
+			{
+				pipeline->statistics.starved++;
+			}
+		}
+	}
+}
+
+uint8_t LP5024_Pipeline_Init(lp5024_Pipeline_t *pipeline, lp5024_Device_t *device, uint8_t rgb)
+{
+	/* Checks for input errors, frames are OUTx images of LP5018 and LP5024. */
+	if (rgb > LP5024_BRG || !LP5024_NATIVE_LAYOUT(device))
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	memset(pipeline, 0, sizeof(*pipeline));
+	pipeline->device = device;
+	pipeline->map = &LP5024_ChannelMaps[rgb];
+#if LP5024_PIPELINE_HEADER
+	/* Reserves register address in front of both frames. */
+	pipeline->buffer[0][0] = LP5024_REG_BRIGHT_LED_0;
+	pipeline->buffer[1][0] = LP5024_REG_BRIGHT_LED_0;
+#endif
+	pipeline->windowStart = LP5024_TIMESTAMP();
+	return LP5024_SUCCESS;
+}
+
+uint8_t *LP5024_Pipeline_GetFrame(lp5024_Pipeline_t *pipeline)
+{
+	if (pipeline->pending)
+	{ /* Both buffers are in use until the bus is free again. */
+		return NULL;
+	}
+	return &pipeline->buffer[pipeline->render][LP5024_PIPELINE_HEADER];
+}
+
+uint8_t *LP5024_Pipeline_GetLED(lp5024_Pipeline_t *pipeline, uint8_t rgbLED)
+{
+	if (pipeline->pending || rgbLED >= LP5024_RGBLED_COUNT)
+	{ /* Both buffers are in use until the bus is free again. */
+		return NULL;
+	}
+	return &pipeline->buffer[pipeline->render][LP5024_PIPELINE_HEADER + (rgbLED * 3)];
+}
+
+const lp5024_ChannelMap_t *LP5024_Pipeline_GetChannelMap(lp5024_Pipeline_t *pipeline)
+{
+	return pipeline->map;
+}
+
+uint8_t LP5024_Pipeline_SetLEDColourRGB(lp5024_Pipeline_t *pipeline, uint8_t rgbLED, uint8_t red, uint8_t green, uint8_t blue)
+{
+	uint8_t *led = NULL;
+	if (rgbLED >= LP5024_RGBLED_COUNT)
+	{ /* Checks for input errors. */
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	led = LP5024_Pipeline_GetLED(pipeline, rgbLED);
+	if (led == NULL)
+	{
+		return HAL_BUSY;
+	}
+	LP5024_PUT_RGB(led, pipeline->map, red, green, blue);
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Pipeline_Submit(lp5024_Pipeline_t *pipeline)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = HAL_OK;
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	if (pipeline->pending && (pipeline->busy || pipeline->sending))
+	{ /* Rejects frame, previous one did not reach the bus yet. */
+		status = HAL_BUSY;
+	}
+	else
+	{
+		if (pipeline->busy || pipeline->sending)
+		{ /* Frame is started by completion of current transfer. */
+			pipeline->statistics.stalls++;
+		}
+		pipeline->pending = 1;
+	}
+	if (!pipeline->busy)
+	{ /* Also retries a transaction that failed to start before. */
+		uint8_t next = LP5024_Pipeline_Next(pipeline);
+		if (status == HAL_OK)
+		{
+			status = next;
+		}
+	}
+	__set_PRIMASK(primask);
+	return status;
+}
+
+uint8_t LP5024_Pipeline_Queue(lp5024_Pipeline_t *pipeline)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = HAL_OK;
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	if (pipeline->busy || pipeline->pending || pipeline->sending)
+	{
+		status = HAL_BUSY;
+	}
+	else
+	{
+		pipeline->pending = 1;
+	}
+	__set_PRIMASK(primask);
+	return status;
+}
+
+uint8_t LP5024_Pipeline_WriteUrgent(lp5024_Pipeline_t *pipeline, uint8_t regAdress, uint8_t value)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = HAL_OK;
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	if (pipeline->queueCount >= LP5024_PIPELINE_URGENT_SLOTS)
+	{
+		status = HAL_BUSY;
+	}
+	else
+	{
+		lp5024_UrgentWrite_t *write = &pipeline->queue[(pipeline->queueHead + pipeline->queueCount) % LP5024_PIPELINE_URGENT_SLOTS];
+		write->data[0] = regAdress;
+		write->data[1] = value;
+		write->timestamp = LP5024_TIMESTAMP();
+		pipeline->queueCount++;
+		LP5024_NotifyTransfer(pipeline->device, 1);
+		if (!pipeline->busy)
+		{ /* A failed start leaves the write queued for the next transaction boundary. */
+			status = LP5024_Pipeline_Next(pipeline);
+		}
+	}
+	__set_PRIMASK(primask);
+	return status;
+}
+
+void LP5024_Pipeline_TxCpltCallback(lp5024_Pipeline_t *pipeline, I2C_HandleTypeDef *hi2c)
+{
+	if (hi2c != pipeline->device->hi2c || !pipeline->busy)
+	{ /* Ignores transfers of other drivers. */
+		return;
+	}
+	LP5024_Pipeline_Finish(pipeline, 1);
+	if (LP5024_Pipeline_Next(pipeline) != HAL_OK)
+	{
+		pipeline->statistics.errors++;
+	}
+}
+
+void LP5024_Pipeline_ErrorCallback(lp5024_Pipeline_t *pipeline, I2C_HandleTypeDef *hi2c)
+{
+	if (hi2c != pipeline->device->hi2c || !pipeline->busy)
+	{ /* Ignores transfers of other drivers. */
+		return;
+	}
+	pipeline->statistics.errors++;
+	LP5024_Pipeline_Finish(pipeline, 0);
+	if (LP5024_Pipeline_Next(pipeline) != HAL_OK)
+	{
+		pipeline->statistics.errors++;
+	}
+}
+
+void LP5024_Pipeline_GetStats(lp5024_Pipeline_t *pipeline, lp5024_PipelineStats_t *statistics, uint8_t reset)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	uint32_t now = LP5024_TIMESTAMP();
+	uint32_t elapsed = now - pipeline->windowStart;
+	uint32_t busTicks = pipeline->busTicks;
+	*statistics = *(lp5024_PipelineStats_t *)&pipeline->statistics;
+	if (pipeline->busy)
+	{ /* Counts running transfer up to now. */
+		busTicks += now - pipeline->transferStart;
+	}
+	if (reset)
+	{
+		memset((void *)&pipeline->statistics, 0, sizeof(pipeline->statistics));
+		pipeline->busTicks = 0;
+		pipeline->windowStart = now;
+		if (pipeline->busy)
+		{
+			pipeline->transferStart = now;
+		}
+	}
+	__set_PRIMASK(primask);
+	if (elapsed > 0)
+	{
+		statistics->frameRate = (uint32_t)(((uint64_t)statistics->frames * LP5024_TIMESTAMP_HZ) / elapsed);
+		statistics->busUtilisation = (uint8_t)(((uint64_t)busTicks * 100) / elapsed);
+	}
+}
+
+uint8_t LP5024_Frame_SetLEDColourRGB(uint8_t *frame, uint8_t rgb, uint8_t rgbLED, uint8_t red, uint8_t green, uint8_t blue)
+{
+	/* Checks for input errors. */
+	if (rgb > LP5024_BRG || rgbLED >= LP5024_RGBLED_COUNT)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	frame += rgbLED * 3;
+	LP5024_PUT_RGB(frame, &LP5024_ChannelMaps[rgb], red, green, blue);
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Frame_SetLEDColourHSB(uint8_t *frame, uint8_t rgb, uint8_t rgbLED, uint16_t hue, uint8_t saturation, uint8_t brightness)
+{
+	uint8_t red = 0;
+	uint8_t green = 0;
+	uint8_t blue = 0;
+	/* Checks for input errors. */
+	if (hue >= 360 || saturation > 100 || brightness > 100)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	HSVtoRGB(&red, &green, &blue, hue, saturation, brightness);
+	return LP5024_Frame_SetLEDColourRGB(frame, rgb, rgbLED, red, green, blue);
+}
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
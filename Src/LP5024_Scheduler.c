@@ -0,0 +1,136 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Scheduler.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Frame pacing for Texas Instruments LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ ******************************************************************************
+ */
+
+/** @addtogroup IC_Drivers
+ * @{
+ */
+
+/** @addtogroup LED_Driver
+ * @{
+ */
+
+#include "LP5024_Scheduler.h"
+#include <string.h> // For initialisation.
+
+/* Accounts transfers of all driver functions on the scheduled bus, also called from transfer interrupts. */
+static void LP5024_Scheduler_Account(void *context, lp5024_Device_t *device, uint16_t length)
+{
+	lp5024_Scheduler_t *scheduler = context;
+	if (scheduler->own)
+	{ /* Own frames are accounted at admission. */
+		return;
+	}
+	uint32_t cost = LP5024_Scheduler_Cost(scheduler, length);
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	scheduler->trafficMicros += cost;
+	__set_PRIMASK(primask);
+}
+
+uint8_t LP5024_Scheduler_Init(lp5024_Scheduler_t *scheduler, lp5024_Pipeline_t *pipeline, uint32_t busSpeed, uint32_t frameRate)
+{
+	/* Checks for input errors. */
+	if (busSpeed == 0 || frameRate == 0 || frameRate > LP5024_TIMESTAMP_HZ)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	memset(scheduler, 0, sizeof(*scheduler));
+	scheduler->pipeline = pipeline;
+	scheduler->busSpeed = busSpeed;
+	scheduler->period = LP5024_TIMESTAMP_HZ / frameRate;
+	scheduler->periodMicros = 1000000 / frameRate;
+	scheduler->nextSlot = LP5024_TIMESTAMP() + scheduler->period;
+	return LP5024_SetTransferHook(pipeline->device->hi2c, LP5024_Scheduler_Account, scheduler);
+}
+
+uint32_t LP5024_Scheduler_Cost(lp5024_Scheduler_t *scheduler, uint16_t length)
+{
+	uint32_t bits = LP5024_SCHEDULER_OVERHEAD_BITS + (9 * (uint32_t)length);
+	return (uint32_t)(((uint64_t)bits * 1000000) / scheduler->busSpeed);
+}
+
+void LP5024_Scheduler_Request(lp5024_Scheduler_t *scheduler)
+{
+	if (scheduler->requested)
+	{ /* Previous render never reached the bus, the new one replaces it. */
+		scheduler->statistics.merged++;
+	}
+	scheduler->requested = 1;
+}
+
+uint8_t LP5024_Scheduler_Tick(lp5024_Scheduler_t *scheduler)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = HAL_OK;
+	uint32_t now = LP5024_TIMESTAMP();
+	uint32_t late = now - scheduler->nextSlot;
+	uint32_t traffic = 0;
+	uint32_t cost = LP5024_Scheduler_Cost(scheduler, LP5024_LED_COUNT);
+	if ((int32_t)late < 0)
+	{ /* Slot not due yet. */
+		return HAL_OK;
+	}
+	/* Skips slots that passed completely, a late frame is not sent twice. */
+	scheduler->nextSlot += scheduler->period * ((late / scheduler->period) + 1);
+	/* Takes traffic of the slot, completion interrupts add to it. */
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	traffic = scheduler->trafficMicros;
+	scheduler->trafficMicros = 0;
+	__set_PRIMASK(primask);
+	scheduler->statistics.slots++;
+	scheduler->statistics.jitterSum += late;
+	if (late > scheduler->statistics.jitterMax)
+	{
+		scheduler->statistics.jitterMax = late;
+	}
+	if (scheduler->requested)
+	{
+		if (scheduler->pipeline->busy || scheduler->pipeline->pending || traffic + cost > scheduler->periodMicros)
+		{ /* Frame stays in the render buffer and is merged with later renders. */
+			scheduler->statistics.dropped++;
+		}
+		else
+		{
+			scheduler->own = 1;
+			status = LP5024_Pipeline_Submit(scheduler->pipeline);
+			scheduler->own = 0;
+			if (status == HAL_OK)
+			{
+				scheduler->requested = 0;
+				scheduler->statistics.frames++;
+				traffic += cost;
+			}
+		}
+	}
+	if (traffic > scheduler->periodMicros)
+	{
+		traffic = scheduler->periodMicros;
+	}
+	scheduler->statistics.busLoad = (uint8_t)(((uint64_t)traffic * 100) / scheduler->periodMicros);
+	return status;
+}
+
+void LP5024_Scheduler_GetStats(lp5024_Scheduler_t *scheduler, lp5024_SchedulerStats_t *statistics, uint8_t reset)
+{
+	*statistics = scheduler->statistics;
+	if (reset)
+	{
+		memset(&scheduler->statistics, 0, sizeof(scheduler->statistics));
+	}
+}
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
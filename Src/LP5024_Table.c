@@ -0,0 +1,209 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Table.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Device table of many Texas Instruments LP5024 LED driver ICs.
+ * @date 	Dec 7, 2023
+ ******************************************************************************
+ */
+
+/** @addtogroup IC_Drivers
+ * @{
+ */
+
+/** @addtogroup LED_Driver
+ * @{
+ */
+
+#include "LP5024_Table.h"
+#include <string.h> // For initialisation.
+
+#define LP5024_CONFIG_RESET (0x3C) ///< Configuration register after reset.
+
+/* Writes consecutive registers of one chip, chips of the table have no register shadow. */
+static uint8_t LP5024_Table_Write(lp5024_DeviceTable_t *table, lp5024_Handle_t handle, uint8_t regAdress, uint8_t *data, uint16_t length)
+{
+	lp5024_Device_t device = {table->hi2c[handle], table->a0[handle], NULL, NULL, NULL, NULL};
+	return LP5024_WriteRegisters(&device, regAdress, data, length);
+}
+
+void LP5024_Table_Init(lp5024_DeviceTable_t *table)
+{
+	memset(table, 0, sizeof(*table));
+}
+
+uint8_t LP5024_Table_Add(lp5024_DeviceTable_t *table, I2C_HandleTypeDef *hi2c, lp5024_A0_t a0, lp5024_Handle_t *handle)
+{
+	/* Checks for input errors. */
+	if (table->count >= LP5024_TABLE_MAX_DEVICES || a0 > LP5024_A1_VDD_A0_VDD)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	*handle = table->count++;
+	table->hi2c[*handle] = hi2c;
+	table->a0[*handle] = a0;
+	table->config[*handle] = LP5024_CONFIG_RESET;
+	memset(table->brightness[*handle], 0xFF, LP5024_RGBLED_COUNT);
+	memset(table->frame[*handle], 0, LP5024_LED_COUNT);
+	return LP5024_SUCCESS;
+}
+
+void LP5024_Table_GetDevice(lp5024_DeviceTable_t *table, lp5024_Handle_t handle, lp5024_Device_t *device)
+{
+	device->hi2c = table->hi2c[handle];
+	device->a0 = table->a0[handle];
+	device->shadow = NULL;
+	device->part = NULL;
+	device->policy = NULL;
+	device->stage = NULL;
+}
+
+uint8_t *LP5024_Table_GetFrame(lp5024_DeviceTable_t *table, lp5024_Handle_t handle)
+{
+	/* Checks for input errors. */
+	if (handle >= table->count)
+	{
+		return NULL;
+	}
+	LP5024_MASK_MARK(table->dirty, handle);
+	return table->frame[handle];
+}
+
+uint8_t LP5024_Table_MarkDirty(lp5024_DeviceTable_t *table, lp5024_Handle_t handle)
+{
+	/* Checks for input errors. */
+	if (handle >= table->count)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	LP5024_MASK_MARK(table->dirty, handle);
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Table_IsDirty(lp5024_DeviceTable_t *table, lp5024_Handle_t handle)
+{
+	return handle < table->count && LP5024_MASK_IS_MARKED(table->dirty, handle);
+}
+
+uint8_t LP5024_Table_SetLEDColourRGB(lp5024_DeviceTable_t *table, lp5024_Handle_t handle, uint8_t rgb, uint8_t rgbLED, uint8_t red, uint8_t green, uint8_t blue)
+{
+	/* Checks for input errors. */
+	if (handle >= table->count || rgb > LP5024_BRG || rgbLED >= LP5024_RGBLED_COUNT)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	uint8_t *led = &table->frame[handle][rgbLED * 3];
+	LP5024_PUT_RGB(led, &LP5024_ChannelMaps[rgb], red, green, blue);
+	LP5024_MASK_MARK(table->dirty, handle);
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Table_FillRGB(lp5024_DeviceTable_t *table, lp5024_Handle_t first, uint8_t count, uint8_t rgb, uint8_t red, uint8_t green, uint8_t blue)
+{
+	uint8_t pattern[3];
+	/* Checks for input errors. */
+	if (first + count > table->count || rgb > LP5024_BRG)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	LP5024_PUT_RGB(pattern, &LP5024_ChannelMaps[rgb], red, green, blue);
+	/* Images of the range are contiguous, so the range is filled in one pass. */
+	uint8_t *out = table->frame[first];
+	for (uint16_t led = 0; led < (uint16_t)count * LP5024_RGBLED_COUNT; led++)
+	{
+		*out++ = pattern[0];
+		*out++ = pattern[1];
+		*out++ = pattern[2];
+	}
+	for (uint16_t handle = first; handle < first + count; handle++)
+	{
+		LP5024_MASK_MARK(table->dirty, handle);
+	}
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Table_Flush(lp5024_DeviceTable_t *table, lp5024_Handle_t first, uint8_t count)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = 0;
+	/* Checks for input errors. */
+	if (first + count > table->count)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	for (uint16_t handle = first; handle < first + count; handle++)
+	{
+		if (!LP5024_MASK_IS_MARKED(table->dirty, handle))
+		{ /* Skips unchanged chips. */
+			continue;
+		}
+		status = LP5024_Table_Write(table, handle, LP5024_REG_BRIGHT_LED_0, table->frame[handle], LP5024_LED_COUNT);
+		if (status > HAL_OK)
+		{ /* Keeps chip marked, so next flush retries. */
+			return status;
+		}
+		LP5024_MASK_CLEAR(table->dirty, handle);
+	}
+	return status;
+}
+
+uint8_t LP5024_Table_SetRGBLEDBrightness(lp5024_DeviceTable_t *table, lp5024_Handle_t first, uint8_t count, const uint8_t *brightness)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = 0;
+	/* Checks for input errors. */
+	if (first + count > table->count)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	for (uint16_t handle = first; handle < first + count; handle++)
+	{
+		if (memcmp(table->brightness[handle], brightness, LP5024_RGBLED_COUNT) == 0)
+		{ /* Skips chips already at the requested brightness. */
+			continue;
+		}
+		status = LP5024_Table_Write(table, handle, LP5024_REG_BRIGHT_RGB_0, (uint8_t *)brightness, LP5024_RGBLED_COUNT);
+		if (status > HAL_OK)
+		{
+			return status;
+		}
+		memcpy(table->brightness[handle], brightness, LP5024_RGBLED_COUNT);
+	}
+	return status;
+}
+
+uint8_t LP5024_Table_UpdateConfig(lp5024_DeviceTable_t *table, lp5024_Handle_t first, uint8_t count, uint8_t mask, uint8_t bits)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = 0;
+	/* Checks for input errors. */
+	if (first + count > table->count)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	for (uint16_t handle = first; handle < first + count; handle++)
+	{
+		/* Combines shadow of register with value that has to be changed. */
+		uint8_t data = (table->config[handle] & ~mask) | (bits & mask);
+		if (data == table->config[handle])
+		{ /* Skips chips already configured. */
+			continue;
+		}
+		status = LP5024_Table_Write(table, handle, LP5024_REG_CONFIG, &data, 1);
+		if (status > HAL_OK)
+		{
+			return status;
+		}
+		table->config[handle] = data;
+	}
+	return status;
+}
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
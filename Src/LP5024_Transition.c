@@ -0,0 +1,264 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Transition.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Time based transitions for Texas Instruments LP5024 LED driver IC.
+ * @date 	Dec 7, 2023
+ ******************************************************************************
+ */
+
+/** @addtogroup IC_Drivers
+ * @{
+ */
+
+/** @addtogroup LED_Driver
+ * @{
+ */
+
+#include "LP5024_Transition.h"
+#include <string.h> // For initialisation.
+
+#define LP5024_TRANSITION_ONE (0x10000) ///< Full progress in fixed point.
+
+/* Returns eased progress of a transition at a timestamp, 0 to LP5024_TRANSITION_ONE. */
+static int32_t LP5024_Transition_Progress(lp5024_Transition_t *transition, uint32_t now)
+{
+	uint32_t elapsed = now - transition->start;
+	if (elapsed >= transition->duration)
+	{
+		return LP5024_TRANSITION_ONE;
+	}
+	int32_t p = (int32_t)(((uint64_t)elapsed * LP5024_TRANSITION_ONE) / transition->duration);
+	int32_t q = LP5024_TRANSITION_ONE - p;
+	switch (transition->easing)
+	{
+	case LP5024_EaseIn:
+		return (int32_t)(((int64_t)p * p) >> 16);
+	case LP5024_EaseOut:
+		return LP5024_TRANSITION_ONE - (int32_t)(((int64_t)q * q) >> 16);
+	case LP5024_EaseInOut:
+		if (p < LP5024_TRANSITION_ONE / 2)
+		{
+			return (int32_t)(((int64_t)p * p) >> 15);
+		}
+		return LP5024_TRANSITION_ONE - (int32_t)(((int64_t)q * q) >> 15);
+	default:
+		return p;
+	}
+}
+
+/* Converts colour to HSB, hue is kept if the colour has none. */
+static void LP5024_Transition_RGBtoHSB(const uint8_t *rgb, int16_t *hsb)
+{
+	uint8_t max = rgb[0] > rgb[1] ? rgb[0] : rgb[1];
+	uint8_t min = rgb[0] < rgb[1] ? rgb[0] : rgb[1];
+	max = rgb[2] > max ? rgb[2] : max;
+	min = rgb[2] < min ? rgb[2] : min;
+	int16_t delta = max - min;
+	hsb[2] = (max * 100 + 127) / 255;
+	hsb[1] = max > 0 ? (delta * 100 + (max / 2)) / max : 0;
+	if (delta == 0)
+	{
+		return;
+	}
+	if (max == rgb[0])
+	{
+		hsb[0] = (360 + ((60 * (rgb[1] - rgb[2])) / delta)) % 360;
+	}
+	else if (max == rgb[1])
+	{
+		hsb[0] = 120 + ((60 * (rgb[2] - rgb[0])) / delta);
+	}
+	else
+	{
+		hsb[0] = 240 + ((60 * (rgb[0] - rgb[1])) / delta);
+	}
+}
+
+/* Starts transition from the value reached so far, also after a finished transition in the same space. */
+static void LP5024_Transition_Start(lp5024_Transition_t *transition, uint8_t space, const int16_t *from, const int16_t *to, uint32_t duration, lp5024_Easing_t easing)
+{
+	if (transition->space != space)
+	{
+		memcpy(transition->value, from, sizeof(transition->value));
+	}
+	memcpy(transition->from, transition->value, sizeof(transition->from));
+	memcpy(transition->to, to, sizeof(transition->to));
+	if (space == LP5024_TransitionHSB)
+	{ /* Takes the shorter way around the hue circle. */
+		if (transition->to[0] - transition->from[0] > 180)
+		{
+			transition->from[0] += 360;
+		}
+		else if (transition->from[0] - transition->to[0] > 180)
+		{
+			transition->from[0] -= 360;
+		}
+	}
+	transition->easing = easing;
+	transition->start = LP5024_TIMESTAMP();
+	transition->duration = duration;
+	transition->space = space;
+	transition->active = 1;
+}
+
+void LP5024_Transition_Init(lp5024_Transitions_t *transitions, lp5024_Pipeline_t *pipeline)
+{
+	memset(transitions, 0, sizeof(*transitions));
+	transitions->pipeline = pipeline;
+	/* Brightness registers after reset. */
+	memset(transitions->level, 0xFF, sizeof(transitions->level));
+}
+
+uint8_t LP5024_Transition_StartRGB(lp5024_Transitions_t *transitions, uint8_t rgbLED, uint8_t red, uint8_t green, uint8_t blue, uint32_t duration, lp5024_Easing_t easing)
+{
+	/* Checks for input errors. */
+	if (rgbLED >= LP5024_RGBLED_COUNT || easing > LP5024_EaseInOut)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	const uint8_t *rgb = transitions->rgb[rgbLED];
+	int16_t from[3] = {rgb[0], rgb[1], rgb[2]};
+	int16_t to[3] = {red, green, blue};
+	LP5024_Transition_Start(&transitions->colour[rgbLED], LP5024_TransitionRGB, from, to, duration, easing);
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Transition_StartHSB(lp5024_Transitions_t *transitions, uint8_t rgbLED, uint16_t hue, uint8_t saturation, uint8_t brightness, uint32_t duration, lp5024_Easing_t easing)
+{
+	/* Checks for input errors. */
+	if (rgbLED >= LP5024_RGBLED_COUNT || easing > LP5024_EaseInOut || hue >= 360 || saturation > 100 || brightness > 100)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	/* Colours without hue start at the target hue. */
+	int16_t from[3] = {hue, 0, 0};
+	int16_t to[3] = {hue, saturation, brightness};
+	LP5024_Transition_RGBtoHSB(transitions->rgb[rgbLED], from);
+	LP5024_Transition_Start(&transitions->colour[rgbLED], LP5024_TransitionHSB, from, to, duration, easing);
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Transition_StartBrightness(lp5024_Transitions_t *transitions, uint8_t rgbLED, uint8_t brightness, uint32_t duration, lp5024_Easing_t easing)
+{
+	/* Checks for input errors. */
+	if (rgbLED >= LP5024_RGBLED_COUNT || easing > LP5024_EaseInOut)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	int16_t from[3] = {transitions->level[rgbLED], 0, 0};
+	int16_t to[3] = {brightness, 0, 0};
+	LP5024_Transition_Start(&transitions->brightness[rgbLED], LP5024_TransitionBrightness, from, to, duration, easing);
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Transition_Cancel(lp5024_Transitions_t *transitions, uint8_t rgbLED)
+{
+	/* Checks for input errors. */
+	if (rgbLED >= LP5024_RGBLED_COUNT)
+	{
+		return LP5024_INPUTOUTOFRANGE;
+	}
+	transitions->colour[rgbLED].active = 0;
+	transitions->brightness[rgbLED].active = 0;
+	return LP5024_SUCCESS;
+}
+
+uint8_t LP5024_Transition_IsActive(lp5024_Transitions_t *transitions, uint8_t rgbLED)
+{
+	return rgbLED < LP5024_RGBLED_COUNT &&
+		   (transitions->colour[rgbLED].active || transitions->brightness[rgbLED].active);
+}
+
+uint8_t LP5024_Transition_Tick(lp5024_Transitions_t *transitions)
+{
+	/* Holds i2c status for error catching. */
+	uint8_t status = HAL_OK;
+	uint8_t active = 0;
+	uint32_t now = LP5024_TIMESTAMP();
+	for (uint8_t rgbLED = 0; rgbLED < LP5024_RGBLED_COUNT; rgbLED++)
+	{
+		active |= LP5024_Transition_IsActive(transitions, rgbLED);
+	}
+	if (!active)
+	{
+		return HAL_OK;
+	}
+	transitions->statistics.ticks++;
+	uint8_t *frame = LP5024_Pipeline_GetFrame(transitions->pipeline);
+	if (frame == NULL)
+	{ /* Values of this tick are skipped, the next tick samples at its own time. */
+		transitions->statistics.skipped++;
+		return HAL_BUSY;
+	}
+	uint32_t cycles = LP5024_CYCLES();
+	for (uint8_t rgbLED = 0; rgbLED < LP5024_RGBLED_COUNT; rgbLED++)
+	{
+		lp5024_Transition_t *transition = &transitions->colour[rgbLED];
+		if (transition->active)
+		{
+			int32_t progress = LP5024_Transition_Progress(transition, now);
+			uint8_t *rgb = transitions->rgb[rgbLED];
+			for (uint8_t channel = 0; channel < 3; channel++)
+			{
+				transition->value[channel] = transition->from[channel] +
+											 (int16_t)(((int32_t)(transition->to[channel] - transition->from[channel]) * progress) >> 16);
+			}
+			if (transition->space == LP5024_TransitionHSB)
+			{
+				transition->value[0] = (transition->value[0] + 360) % 360;
+				HSVtoRGB(&rgb[0], &rgb[1], &rgb[2], transition->value[0], transition->value[1], transition->value[2]);
+			}
+			else
+			{
+				rgb[0] = transition->value[0];
+				rgb[1] = transition->value[1];
+				rgb[2] = transition->value[2];
+			}
+			LP5024_PUT_RGB(&frame[rgbLED * 3], LP5024_Pipeline_GetChannelMap(transitions->pipeline), rgb[0], rgb[1], rgb[2]);
+			if (progress == LP5024_TRANSITION_ONE)
+			{
+				transition->active = 0;
+			}
+			transitions->statistics.samples++;
+		}
+		transition = &transitions->brightness[rgbLED];
+		if (transition->active)
+		{
+			int32_t progress = LP5024_Transition_Progress(transition, now);
+			uint8_t level = transition->from[0] + (((int32_t)(transition->to[0] - transition->from[0]) * progress) >> 16);
+			if (level != transitions->level[rgbLED] &&
+				LP5024_Pipeline_WriteUrgent(transitions->pipeline, LP5024_REG_BRIGHT_RGB_0 + rgbLED, level) == HAL_OK)
+			{ /* A full urgent queue skips this value. */
+				transitions->level[rgbLED] = level;
+			}
+			transition->value[0] = transitions->level[rgbLED];
+			if (progress == LP5024_TRANSITION_ONE && level == transitions->level[rgbLED])
+			{
+				transition->active = 0;
+			}
+			transitions->statistics.samples++;
+		}
+	}
+	transitions->statistics.cycles += LP5024_CYCLES() - cycles;
+	status = LP5024_Pipeline_Submit(transitions->pipeline);
+	return status;
+}
+
+void LP5024_Transition_GetStats(lp5024_Transitions_t *transitions, lp5024_TransitionStats_t *statistics, uint8_t reset)
+{
+	*statistics = transitions->statistics;
+	if (reset)
+	{
+		memset(&transitions->statistics, 0, sizeof(transitions->statistics));
+	}
+}
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,134 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_BusGuard_Test.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Fault injection test of bus hang detection and recovery.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * The simulated bus answers with injected HAL_TIMEOUT, HAL_BUSY or HAL_ERROR
+ * (NACK). Times are simulated ticks, a blocking call answering HAL_TIMEOUT
+ * costs its timeout and one answering HAL_BUSY the busy flag wait of the HAL.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#include "LP5024.h"
+#include "LP5024_Test.h"
+#include <string.h>
+
+static I2C_HandleTypeDef hi2c;
+static uint32_t hookCalls;
+static uint32_t healAt;
+
+/* Frees the bus from the given call on, like clock pulses and reinit would. */
+static uint8_t LP5024_Test_Recover(void *context, I2C_HandleTypeDef *hi2c)
+{
+	(void)context;
+	hookCalls++;
+	HAL_I2C_DeInit(hi2c);
+	HAL_I2C_Init(hi2c);
+	if (hookCalls < healAt)
+	{
+		return HAL_ERROR;
+	}
+	Sim_InjectFault(hi2c, HAL_OK, 0);
+	return HAL_OK;
+}
+
+/* Chip lost its state, e.g. reset by the recovery. */
+static void LP5024_Test_ResetChip(uint8_t *reg)
+{
+	memset(reg, 0, SIM_REG_COUNT);
+	reg[LP5024_REG_CONFIG] = 0x3C;
+}
+
+int main(void)
+{
+	uint8_t *reg;
+	uint8_t status;
+	uint32_t start;
+	Sim_Stats_t bus;
+	lp5024_Shadow_t shadow;
+	lp5024_BusGuard_t guard;
+	lp5024_BusGuardStats_t statistics;
+	lp5024_Device_t device = {&hi2c, LP5024_A1_GND_A0_GND, &shadow, NULL, NULL, NULL};
+
+	Sim_Reset();
+	reg = Sim_Registers(&hi2c, 0x28);
+	LP5024_InitShadow(&shadow, LP5024_IdleStayOn, 0);
+	LP5024_TEST_CHECK(LP5024_SetLEDColourRGB(&device, LP5024_RGB, 2, 7, 8, 9) == LP5024_SUCCESS);
+
+	/* Unguarded, a wedged bus burns every attempt. */
+	Sim_InjectFault(&hi2c, HAL_TIMEOUT, UINT32_MAX);
+	start = HAL_GetTick();
+	status = LP5024_SetLEDColourRGB(&device, LP5024_RGB, 1, 1, 1, 1);
+	LP5024_TEST_CHECK(status == HAL_TIMEOUT);
+	LP5024_TEST_CHECK(HAL_GetTick() - start == (LP5024_I2C_MAX_ATTEMPTS + 1) * (LP5024_I2C_TIMEOUT + LP5024_I2C_ATTEMPT_DELAY));
+	printf("unguarded wedged call: %u ms\n", (unsigned)(HAL_GetTick() - start));
+
+	/* A NACK is an answer of the bus and no hang. */
+	LP5024_TEST_CHECK(LP5024_AddBusGuard(&guard, &hi2c, 3, 50, LP5024_Test_Recover, NULL) == LP5024_SUCCESS);
+	Sim_InjectFault(&hi2c, HAL_ERROR, 5);
+	for (uint8_t i = 0; i < 5; i++)
+	{
+		LP5024_TEST_CHECK(LP5024_SetLEDColourRGB(&device, LP5024_RGB, 1, 1, 1, 1) == HAL_ERROR);
+	}
+	LP5024_GetBusGuardStats(&guard, &statistics, 0);
+	LP5024_TEST_CHECK(statistics.hangs == 0 && !guard.hung);
+
+	/* Hang detected after threshold, first recovery attempt fails. */
+	Sim_InjectFault(&hi2c, HAL_TIMEOUT, UINT32_MAX);
+	hookCalls = 0;
+	healAt = 2;
+	start = HAL_GetTick();
+	LP5024_TEST_CHECK(LP5024_SetLEDColourRGB(&device, LP5024_RGB, 1, 1, 1, 1) == HAL_BUSY);
+	LP5024_TEST_CHECK(HAL_GetTick() - start == 3 * LP5024_I2C_TIMEOUT + 2 * LP5024_I2C_ATTEMPT_DELAY);
+	LP5024_TEST_CHECK(guard.hung && hookCalls == 1);
+	printf("guarded call detecting the hang: %u ms\n", (unsigned)(HAL_GetTick() - start));
+
+	/* Within holdoff calls fail fast without touching the bus. */
+	Sim_GetStats(&hi2c, &bus, 1);
+	start = HAL_GetTick();
+	for (uint8_t i = 0; i < 10; i++)
+	{
+		LP5024_TEST_CHECK(LP5024_SetLEDColourRGB(&device, LP5024_RGB, 1, 1, 1, 1) == HAL_BUSY);
+	}
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(HAL_GetTick() == start && bus.blocking == 0 && hookCalls == 1);
+	printf("calls within holdoff: %u ms, %u bus calls\n", (unsigned)(HAL_GetTick() - start), (unsigned)bus.blocking);
+
+	/* Recovery after holdoff, chip lost its state and is restored from the shadow. */
+	LP5024_Test_ResetChip(reg);
+	Sim_Advance(50);
+	LP5024_TEST_CHECK(LP5024_SetLEDColourRGB(&device, LP5024_RGB, 3, 4, 5, 6) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(memcmp(reg, shadow.reg, LP5024_REG_COUNT) == 0);
+	LP5024_TEST_CHECK(reg[LP5024_REG_BRIGHT_LED_0 + 6] == 7 && reg[LP5024_REG_BRIGHT_LED_0 + 9] == 4);
+	Sim_GetStats(&hi2c, &bus, 1);
+	/* One burst restoring all registers with auto increment, then the three channels of the call. */
+	LP5024_TEST_CHECK(bus.writes == 1 + 3 && bus.inits == 1);
+	LP5024_GetBusGuardStats(&guard, &statistics, 0);
+	LP5024_TEST_CHECK(statistics.hangs == 1 && statistics.recoveries == 1 && statistics.failedRecoveries == 1);
+	LP5024_TEST_CHECK(statistics.fastFails == 11 && statistics.restores == 1);
+	printf("time to recover: %u ms\n", (unsigned)statistics.lastRecovery);
+
+	/* Busy bus is a hang too, restore goes register by register without auto increment. */
+	LP5024_TEST_CHECK(LP5024_SetAutoIncrement(&device, LP5024_DisableAutoIncrement) == LP5024_SUCCESS);
+	Sim_InjectFault(&hi2c, HAL_BUSY, UINT32_MAX);
+	hookCalls = 0;
+	healAt = 1;
+	start = HAL_GetTick();
+	LP5024_TEST_CHECK(LP5024_SetLEDColourRGB(&device, LP5024_RGB, 4, 1, 2, 3) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(HAL_GetTick() - start == 3 * SIM_BUSY_FLAG_TIMEOUT + 2 * LP5024_I2C_ATTEMPT_DELAY);
+	LP5024_TEST_CHECK(memcmp(reg, shadow.reg, LP5024_REG_COUNT) == 0);
+	Sim_GetStats(&hi2c, &bus, 1);
+	/* CONFIG write, one write per register, three channels. */
+	LP5024_TEST_CHECK(bus.writes == 1 + LP5024_REG_COUNT + 3);
+
+	/* Replacing the guard keeps its recovery count, devices are not restored again. */
+	LP5024_TEST_CHECK(LP5024_AddBusGuard(&guard, &hi2c, 3, 50, LP5024_Test_Recover, NULL) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(LP5024_SetLEDColourRGB(&device, LP5024_RGB, 4, 5, 5, 5) == LP5024_SUCCESS);
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(bus.writes == 3);
+	return LP5024_TEST_RESULT();
+}
@@ -0,0 +1,152 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Canvas_Test.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Virtual canvas of 32 LEDs on four chips and two buses.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Every chip is wired differently: forward and reversed runs with four colour
+ * orders. Each logical LED is checked in the simulated registers against the
+ * spelled out wiring, a full update has to cost one burst per chip.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#include "LP5024_Canvas.h"
+#include "LP5024_Test.h"
+#include <stdint.h>
+
+#define LP5024_TEST_CHIPS (4)
+#define LP5024_TEST_LEDS (LP5024_TEST_CHIPS * LP5024_RGBLED_COUNT)
+#define LP5024_TEST_ROUNDS (10000)
+
+/* Wiring of every chip: colour order spelled out by register and direction of its run. */
+static const char *const LP5024_TestOrders[LP5024_TEST_CHIPS] = {"RGB", "GRB", "BRG", "RBG"};
+static const uint8_t LP5024_TestOrderIds[LP5024_TEST_CHIPS] = {LP5024_RGB, LP5024_GRB, LP5024_BRG, LP5024_RBG};
+static const uint8_t LP5024_TestReversed[LP5024_TEST_CHIPS] = {0, 1, 0, 1};
+
+static I2C_HandleTypeDef hi2c[2];
+static lp5024_DeviceTable_t table;
+static lp5024_Canvas_t canvas;
+
+/* Registers of the RGB LED a logical LED is wired to. */
+static const uint8_t *LP5024_Test_Physical(uint16_t index)
+{
+	uint8_t chip = index / LP5024_RGBLED_COUNT;
+	uint8_t led = LP5024_TestReversed[chip] ? LP5024_RGBLED_COUNT - 1 - index % LP5024_RGBLED_COUNT : index % LP5024_RGBLED_COUNT;
+	return &Sim_Registers(&hi2c[chip / 2], 0x28 + chip % 2)[LP5024_REG_BRIGHT_LED_0 + led * 3];
+}
+
+/* Checks a logical LED against the spelled out colour order of its chip. */
+static uint8_t LP5024_Test_IsShown(uint16_t index, uint8_t red, uint8_t green, uint8_t blue)
+{
+	const uint8_t *reg = LP5024_Test_Physical(index);
+	for (uint8_t channel = 0; channel < 3; channel++)
+	{
+		char colour = LP5024_TestOrders[index / LP5024_RGBLED_COUNT][channel];
+		if (reg[channel] != ((colour == 'R') ? red : (colour == 'G') ? green : blue))
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* Sums writes of both buses and resets the counters. */
+static uint32_t LP5024_Test_Writes(uint32_t *perBus)
+{
+	Sim_Stats_t bus;
+	uint32_t writes = 0;
+	for (uint8_t i = 0; i < 2; i++)
+	{
+		Sim_GetStats(&hi2c[i], &bus, 1);
+		perBus[i] = bus.writes;
+		writes += bus.writes;
+	}
+	return writes;
+}
+
+int main(void)
+{
+	lp5024_CanvasMap_t map[LP5024_TEST_LEDS];
+	lp5024_CanvasStats_t statistics;
+	lp5024_Handle_t handle;
+	uint8_t colours[LP5024_TEST_LEDS * 3];
+	uint32_t perBus[2];
+	uint64_t start;
+
+	Sim_Reset();
+	LP5024_Table_Init(&table);
+	for (uint8_t chip = 0; chip < LP5024_TEST_CHIPS; chip++)
+	{
+		LP5024_Table_Add(&table, &hi2c[chip / 2], (lp5024_A0_t)(chip % 2), &handle);
+		uint8_t first = LP5024_TestReversed[chip] ? LP5024_RGBLED_COUNT - 1 : 0;
+		LP5024_TEST_CHECK(LP5024_Canvas_MapRun(&map[chip * LP5024_RGBLED_COUNT], handle, first, LP5024_RGBLED_COUNT, LP5024_TestOrderIds[chip], LP5024_TestReversed[chip]) == LP5024_SUCCESS);
+	}
+	LP5024_TEST_CHECK(LP5024_Canvas_MapRun(map, 0, 3, 5, LP5024_RGB, 1) == LP5024_INPUTOUTOFRANGE);
+	LP5024_TEST_CHECK(LP5024_Canvas_MapRun(map, 0, 4, 5, LP5024_RGB, 0) == LP5024_INPUTOUTOFRANGE);
+	LP5024_TEST_CHECK(LP5024_Canvas_MapRun(map, 0, 0, 1, LP5024_BRG + 1, 0) == LP5024_INPUTOUTOFRANGE);
+	LP5024_TEST_CHECK(LP5024_Canvas_Init(&canvas, &table, map, LP5024_CANVAS_MAX_LEDS + 1) == LP5024_INPUTOUTOFRANGE);
+	LP5024_TEST_CHECK(LP5024_Canvas_Init(&canvas, &table, map, LP5024_TEST_LEDS) == LP5024_SUCCESS);
+
+	/* Full canvas, one burst per chip, two on each bus. */
+	for (uint16_t index = 0; index < LP5024_TEST_LEDS; index++)
+	{
+		colours[index * 3] = index;
+		colours[index * 3 + 1] = 100 + index;
+		colours[index * 3 + 2] = 200 + index;
+	}
+	LP5024_Test_Writes(perBus);
+	LP5024_TEST_CHECK(LP5024_Canvas_Write(&canvas, 0, LP5024_TEST_LEDS, colours) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(LP5024_Canvas_Flush(&canvas) == HAL_OK);
+	LP5024_TEST_CHECK(LP5024_Test_Writes(perBus) == LP5024_TEST_CHIPS && perBus[0] == 2 && perBus[1] == 2);
+	LP5024_Canvas_GetStats(&canvas, &statistics, 1);
+	LP5024_TEST_CHECK(statistics.transactions == LP5024_TEST_CHIPS && statistics.bytes == LP5024_TEST_CHIPS * LP5024_LED_COUNT && statistics.leds == LP5024_TEST_LEDS);
+	for (uint16_t index = 0; index < LP5024_TEST_LEDS; index++)
+	{
+		LP5024_TEST_CHECK(LP5024_Test_IsShown(index, index, 100 + index, 200 + index));
+	}
+
+	/* Neighbours on the strip across a reversed chip boundary. */
+	LP5024_TEST_CHECK(LP5024_Test_Physical(7) == &Sim_Registers(&hi2c[0], 0x28)[LP5024_REG_BRIGHT_LED_0 + 21]);
+	LP5024_TEST_CHECK(LP5024_Test_Physical(8) == &Sim_Registers(&hi2c[0], 0x29)[LP5024_REG_BRIGHT_LED_0 + 21]);
+
+	/* One LED, one burst on its bus only; nothing changed, nothing sent. */
+	LP5024_TEST_CHECK(LP5024_Canvas_SetLED(&canvas, 25, 1, 2, 3) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(LP5024_Canvas_Flush(&canvas) == HAL_OK);
+	LP5024_TEST_CHECK(LP5024_Test_Writes(perBus) == 1 && perBus[1] == 1);
+	LP5024_TEST_CHECK(LP5024_Test_IsShown(25, 1, 2, 3));
+	LP5024_TEST_CHECK(LP5024_Canvas_Flush(&canvas) == HAL_OK);
+	LP5024_TEST_CHECK(LP5024_Test_Writes(perBus) == 0);
+	LP5024_TEST_CHECK(LP5024_Canvas_SetLED(&canvas, LP5024_TEST_LEDS, 0, 0, 0) == LP5024_INPUTOUTOFRANGE);
+
+	/* A failing bus does not hold back the other, its chips are sent by the next flush. */
+	Sim_InjectFault(&hi2c[0], HAL_ERROR, UINT32_MAX);
+	LP5024_Canvas_SetLED(&canvas, 0, 9, 9, 9);
+	LP5024_Canvas_SetLED(&canvas, 31, 8, 8, 8);
+	LP5024_TEST_CHECK(LP5024_Canvas_Flush(&canvas) == HAL_ERROR);
+	LP5024_TEST_CHECK(LP5024_Test_Writes(perBus) == 1 && perBus[1] == 1 && LP5024_Test_IsShown(31, 8, 8, 8));
+	Sim_InjectFault(&hi2c[0], HAL_OK, 0);
+	LP5024_TEST_CHECK(LP5024_Canvas_Flush(&canvas) == HAL_OK);
+	LP5024_TEST_CHECK(LP5024_Test_Writes(perBus) == 1 && perBus[0] == 1 && LP5024_Test_IsShown(0, 9, 9, 9));
+
+	/* Cost of a full canvas update, mapping only and with flush. */
+	start = LP5024_Test_Nanoseconds();
+	for (uint32_t round = 0; round < LP5024_TEST_ROUNDS; round++)
+	{
+		colours[0] = round;
+		LP5024_Canvas_Write(&canvas, 0, LP5024_TEST_LEDS, colours);
+	}
+	printf("mapping %u LEDs: %.0f ns, ", LP5024_TEST_LEDS, (double)(LP5024_Test_Nanoseconds() - start) / LP5024_TEST_ROUNDS);
+	start = LP5024_Test_Nanoseconds();
+	for (uint32_t round = 0; round < LP5024_TEST_ROUNDS; round++)
+	{
+		colours[0] = round;
+		LP5024_Canvas_Write(&canvas, 0, LP5024_TEST_LEDS, colours);
+		LP5024_Canvas_Flush(&canvas);
+	}
+	printf("with flush %.0f ns and %u writes, %u bytes RAM per LED\n", (double)(LP5024_Test_Nanoseconds() - start) / LP5024_TEST_ROUNDS,
+		   (unsigned)(LP5024_Test_Writes(perBus) / LP5024_TEST_ROUNDS), (unsigned)LP5024_CANVAS_BYTES_PER_LED);
+	return LP5024_TEST_RESULT();
+}
@@ -0,0 +1,114 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_ColourOrder_Test.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Sweep of all colour orders over every colour path.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Expected register contents are spelled out per lp5024_ColorOrder_t, so the
+ * test does not depend on LP5024_ChannelMaps it checks.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#include "LP5024.h"
+#include "LP5024_Pipeline.h"
+#include "LP5024_Test.h"
+#include <string.h>
+
+/* Channel in the three registers of an RGB LED, indexed by lp5024_ColorOrder_t. */
+static const char *const LP5024_TestOrders[6] = {"RGB", "RBG", "GRB", "GBR", "BGR", "BRG"};
+
+static I2C_HandleTypeDef hi2c;
+static lp5024_Pipeline_t pipeline;
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	LP5024_Pipeline_TxCpltCallback(&pipeline, hi2c);
+}
+
+/* Checks three registers against the spelled out order. */
+static uint8_t LP5024_Test_IsOrdered(const uint8_t *reg, uint8_t rgb, uint8_t red, uint8_t green, uint8_t blue)
+{
+	for (uint8_t channel = 0; channel < 3; channel++)
+	{
+		char colour = LP5024_TestOrders[rgb][channel];
+		uint8_t expected = (colour == 'R') ? red : (colour == 'G') ? green : blue;
+		if (reg[channel] != expected)
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+int main(void)
+{
+	Sim_Stats_t bus;
+	lp5024_Device_t device = {&hi2c, LP5024_A1_GND_A0_GND, NULL, NULL, NULL, NULL};
+	uint8_t *reg;
+	uint8_t red, green, blue;
+	uint8_t frame[LP5024_LED_COUNT];
+	uint8_t colours[LP5024_RGBLED_COUNT * 3];
+	uint64_t start;
+
+	Sim_Reset();
+	reg = Sim_Registers(&hi2c, 0x28);
+	HSVtoRGB(&red, &green, &blue, 200, 80, 90);
+	for (uint8_t i = 0; i < sizeof(colours); i++)
+	{
+		colours[i] = i + 1;
+	}
+	for (uint8_t rgb = LP5024_RGB; rgb <= LP5024_BRG; rgb++)
+	{
+		LP5024_TEST_CHECK(LP5024_SetTotalColourRGB(&device, rgb, 10, 20, 30) == LP5024_SUCCESS);
+		LP5024_TEST_CHECK(LP5024_Test_IsOrdered(&reg[LP5024_REG_BRIGHT_BANK_A], rgb, 10, 20, 30));
+
+		LP5024_TEST_CHECK(LP5024_SetTotalColourHSB(&device, rgb, 200, 80, 90) == LP5024_SUCCESS);
+		LP5024_TEST_CHECK(LP5024_Test_IsOrdered(&reg[LP5024_REG_BRIGHT_BANK_A], rgb, red, green, blue));
+
+		LP5024_TEST_CHECK(LP5024_SetLEDColourRGB(&device, rgb, 5, 11, 21, 31) == LP5024_SUCCESS);
+		LP5024_TEST_CHECK(LP5024_Test_IsOrdered(&reg[LP5024_REG_BRIGHT_LED_0 + 15], rgb, 11, 21, 31));
+
+		LP5024_TEST_CHECK(LP5024_SetLEDColourHSB(&device, rgb, 2, 200, 80, 90) == LP5024_SUCCESS);
+		LP5024_TEST_CHECK(LP5024_Test_IsOrdered(&reg[LP5024_REG_BRIGHT_LED_0 + 6], rgb, red, green, blue));
+
+		/* Batch of all LEDs in one burst. */
+		Sim_GetStats(&hi2c, &bus, 1);
+		LP5024_TEST_CHECK(LP5024_SetLEDColoursRGB(&device, rgb, 0, LP5024_RGBLED_COUNT, colours) == LP5024_SUCCESS);
+		Sim_GetStats(&hi2c, &bus, 1);
+		LP5024_TEST_CHECK(bus.writes == 1 && bus.bytes == LP5024_LED_COUNT);
+		for (uint8_t led = 0; led < LP5024_RGBLED_COUNT; led++)
+		{
+			LP5024_TEST_CHECK(LP5024_Test_IsOrdered(&reg[LP5024_REG_BRIGHT_LED_0 + led * 3], rgb, colours[led * 3], colours[led * 3 + 1], colours[led * 3 + 2]));
+		}
+
+		memset(frame, 0, sizeof(frame));
+		LP5024_TEST_CHECK(LP5024_Frame_SetLEDColourRGB(frame, rgb, 7, 40, 50, 60) == LP5024_SUCCESS);
+		LP5024_TEST_CHECK(LP5024_Test_IsOrdered(&frame[7 * 3], rgb, 40, 50, 60));
+
+		/* Pipeline renders into its own buffer, checked after the frame was sent. */
+		LP5024_TEST_CHECK(LP5024_Pipeline_Init(&pipeline, &device, rgb) == LP5024_SUCCESS);
+		LP5024_TEST_CHECK(LP5024_Pipeline_SetLEDColourRGB(&pipeline, 3, 70, 80, 90) == LP5024_SUCCESS);
+		LP5024_TEST_CHECK(LP5024_Pipeline_Submit(&pipeline) == LP5024_SUCCESS);
+		while (Sim_Complete(&hi2c))
+		{
+		}
+		LP5024_TEST_CHECK(LP5024_Test_IsOrdered(&reg[LP5024_REG_BRIGHT_LED_0 + 9], rgb, 70, 80, 90));
+	}
+
+	/* Invalid orders are rejected. */
+	LP5024_TEST_CHECK(LP5024_SetLEDColourRGB(&device, LP5024_BRG + 1, 0, 1, 2, 3) == LP5024_INPUTOUTOFRANGE);
+	LP5024_TEST_CHECK(LP5024_SetLEDColoursRGB(&device, LP5024_BRG + 1, 0, 1, colours) == LP5024_INPUTOUTOFRANGE);
+	LP5024_TEST_CHECK(LP5024_Frame_SetLEDColourRGB(frame, LP5024_BRG + 1, 0, 1, 2, 3) == LP5024_INPUTOUTOFRANGE);
+
+	/* Cost of packing one LED through the permutation table. */
+	start = LP5024_Test_Nanoseconds();
+	for (uint32_t i = 0; i < 1000000; i++)
+	{
+		LP5024_Frame_SetLEDColourRGB(frame, i % 6, i & 7, (uint8_t)i, (uint8_t)(i >> 8), (uint8_t)(i >> 16));
+	}
+	printf("packing: %.2f ns per LED\n", (double)(LP5024_Test_Nanoseconds() - start) / 1000000);
+	return LP5024_TEST_RESULT();
+}
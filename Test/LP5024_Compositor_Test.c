@@ -0,0 +1,145 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Compositor_Test.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Layer compositor checked against exact alpha blending and bus traffic.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Every alpha is compared with the rounded division by 255. Flushes have to
+ * blend only LEDs with changed input and send only the span of LEDs with
+ * changed result, a failed flush has to be repeated by the next one.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#include "LP5024_Compositor.h"
+#include "LP5024_Test.h"
+#include <stdint.h>
+#include <string.h>
+
+static I2C_HandleTypeDef hi2c;
+
+/* Rounded blend of one channel, never exactly halfway for a divisor of 255. */
+static uint8_t LP5024_Test_Blend(uint8_t base, uint8_t colour, uint8_t alpha)
+{
+	return (uint8_t)((base * (255 - alpha) + colour * alpha + 127) / 255);
+}
+
+int main(void)
+{
+	lp5024_Device_t device = {&hi2c, LP5024_A1_GND_A0_GND, NULL, NULL, NULL, NULL};
+	lp5024_Device_t lp5036 = {&hi2c, LP5024_A1_GND_A0_GND, NULL, &LP5024_Parts[LP5024_LP5036], NULL, NULL};
+	static const uint8_t bases[4] = {0, 1, 128, 255};
+	static lp5024_Compositor_t compositor;
+	lp5024_CompositorStats_t statistics;
+	const uint8_t *out;
+	Sim_Stats_t bus;
+
+	Sim_Reset();
+	out = &Sim_Registers(&hi2c, 0x28)[LP5024_REG_BRIGHT_LED_0];
+	LP5024_TEST_CHECK(LP5024_Compositor_Init(&compositor, &lp5036, LP5024_RGB) == LP5024_INPUTOUTOFRANGE);
+	LP5024_TEST_CHECK(LP5024_Compositor_Init(&compositor, &device, LP5024_GRB) == LP5024_SUCCESS);
+
+	/* Every alpha over opaque backgrounds, red and blue mixed in opposite directions. */
+	for (uint8_t base = 0; base < 4; base++)
+	{
+		for (uint16_t alpha = 0; alpha <= 255; alpha++)
+		{
+			LP5024_Compositor_SetLED(&compositor, 0, 0, bases[base], 77, 255 - bases[base], 255);
+			LP5024_Compositor_SetLED(&compositor, 1, 0, 255 - bases[base], 77, bases[base], alpha);
+			LP5024_Compositor_Blend(&compositor);
+			LP5024_TEST_CHECK(compositor.image[1] == LP5024_Test_Blend(bases[base], 255 - bases[base], alpha));
+			LP5024_TEST_CHECK(compositor.image[0] == 77);
+			LP5024_TEST_CHECK(compositor.image[2] == LP5024_Test_Blend(255 - bases[base], bases[base], alpha));
+		}
+	}
+
+	/* Three layers blend bottom up on black. */
+	LP5024_Compositor_SetLED(&compositor, 0, 3, 200, 0, 0, 128);
+	LP5024_Compositor_SetLED(&compositor, 1, 3, 0, 100, 0, 64);
+	LP5024_Compositor_SetLED(&compositor, 2, 3, 0, 0, 50, 255);
+	LP5024_Compositor_SetLED(&compositor, 3, 3, 255, 255, 255, 51);
+	LP5024_Compositor_Blend(&compositor);
+	uint8_t red = LP5024_Test_Blend(LP5024_Test_Blend(LP5024_Test_Blend(LP5024_Test_Blend(0, 200, 128), 0, 64), 0, 255), 255, 51);
+	uint8_t blue = LP5024_Test_Blend(LP5024_Test_Blend(LP5024_Test_Blend(LP5024_Test_Blend(0, 0, 128), 0, 64), 50, 255), 255, 51);
+	LP5024_TEST_CHECK(compositor.image[3 * 3 + 1] == red && compositor.image[3 * 3 + 2] == blue);
+
+	/* Background on all LEDs, first flush sends the full image. */
+	for (uint8_t led = 0; led < LP5024_RGBLED_COUNT; led++)
+	{
+		LP5024_Compositor_SetLED(&compositor, 0, led, 10 * led, 20, 30, 255);
+	}
+	LP5024_Compositor_ClearLayer(&compositor, 1);
+	LP5024_Compositor_ClearLayer(&compositor, 2);
+	LP5024_Compositor_ClearLayer(&compositor, 3);
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_Compositor_GetStats(&compositor, &statistics, 1);
+	LP5024_TEST_CHECK(LP5024_Compositor_Flush(&compositor) == HAL_OK);
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(bus.writes == 1 && bus.bytes == LP5024_LED_COUNT);
+	LP5024_TEST_CHECK(memcmp(out, compositor.image, LP5024_LED_COUNT) == 0);
+	LP5024_TEST_CHECK(out[5 * 3 + 1] == 50 && out[5 * 3] == 20 && out[5 * 3 + 2] == 30);
+
+	/* Overlay on one LED: one LED blended, three bytes sent. */
+	LP5024_Compositor_GetStats(&compositor, &statistics, 1);
+	LP5024_Compositor_SetLED(&compositor, 2, 6, 255, 0, 0, 128);
+	LP5024_TEST_CHECK(LP5024_Compositor_Flush(&compositor) == HAL_OK);
+	LP5024_Compositor_GetStats(&compositor, &statistics, 1);
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(statistics.blended == 1 && statistics.transactions == 1 && statistics.bytes == 3);
+	LP5024_TEST_CHECK(bus.writes == 1 && bus.bytes == 3 && out[6 * 3 + 1] == LP5024_Test_Blend(60, 255, 128));
+
+	/* Two LEDs apart: one burst spanning both. */
+	LP5024_Compositor_SetLED(&compositor, 2, 2, 0, 0, 255, 255);
+	LP5024_Compositor_SetLED(&compositor, 2, 5, 0, 0, 255, 255);
+	LP5024_TEST_CHECK(LP5024_Compositor_Flush(&compositor) == HAL_OK);
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(bus.writes == 1 && bus.bytes == 4 * 3);
+
+	/* Same input, or a change hidden below an opaque layer, sends nothing. */
+	LP5024_Compositor_GetStats(&compositor, &statistics, 1);
+	LP5024_Compositor_SetLED(&compositor, 2, 2, 0, 0, 255, 255);
+	LP5024_TEST_CHECK(LP5024_Compositor_Flush(&compositor) == HAL_OK);
+	LP5024_Compositor_SetLED(&compositor, 1, 5, 255, 255, 255, 255);
+	LP5024_TEST_CHECK(LP5024_Compositor_Flush(&compositor) == HAL_OK);
+	LP5024_Compositor_GetStats(&compositor, &statistics, 1);
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(statistics.frames == 2 && statistics.blended == 1 && statistics.transactions == 0 && bus.writes == 0);
+
+	/* A failed flush is sent again by the next one. */
+	LP5024_Compositor_SetLED(&compositor, 3, 7, 1, 2, 3, 255);
+	Sim_InjectFault(&hi2c, HAL_ERROR, UINT32_MAX);
+	LP5024_TEST_CHECK(LP5024_Compositor_Flush(&compositor) == HAL_ERROR);
+	Sim_InjectFault(&hi2c, HAL_OK, 0);
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(LP5024_Compositor_Flush(&compositor) == HAL_OK);
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(bus.writes == 1 && bus.bytes == 3 && out[7 * 3] == 2 && out[7 * 3 + 1] == 1);
+
+	/* Overlay ends, the background comes back. */
+	LP5024_Compositor_ClearLayer(&compositor, 1);
+	LP5024_Compositor_ClearLayer(&compositor, 2);
+	LP5024_Compositor_ClearLayer(&compositor, 3);
+	LP5024_TEST_CHECK(LP5024_Compositor_Flush(&compositor) == HAL_OK);
+	LP5024_TEST_CHECK(out[2 * 3 + 1] == 20 && out[6 * 3 + 1] == 60 && out[7 * 3 + 1] == 70);
+	LP5024_TEST_CHECK(LP5024_Compositor_SetLED(&compositor, LP5024_COMPOSITOR_LAYERS, 0, 0, 0, 0, 0) == LP5024_INPUTOUTOFRANGE);
+	LP5024_TEST_CHECK(LP5024_Compositor_SetAlpha(&compositor, 0, LP5024_RGBLED_COUNT, 0) == LP5024_INPUTOUTOFRANGE);
+
+	/* White cursor stepping over a static background, on and off every other frame. */
+	for (uint8_t led = 0; led < LP5024_RGBLED_COUNT; led++)
+	{
+		LP5024_Compositor_SetLED(&compositor, 3, led, 255, 255, 255, 0);
+	}
+	Sim_GetStats(&hi2c, &bus, 1);
+	for (uint8_t frame = 0; frame < 100; frame++)
+	{
+		LP5024_Compositor_SetAlpha(&compositor, 3, (frame / 2) % LP5024_RGBLED_COUNT, (frame & 1) ? 0 : 255);
+		LP5024_Compositor_Flush(&compositor);
+	}
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(bus.writes == 100 && bus.bytes == 100 * 3);
+	printf("cursor: %u bytes in %u writes for 100 frames, full frames %u bytes\n",
+		   (unsigned)bus.bytes, (unsigned)bus.writes, 100 * LP5024_LED_COUNT);
+	return LP5024_TEST_RESULT();
+}
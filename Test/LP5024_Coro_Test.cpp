@@ -0,0 +1,152 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Coro_Test.cpp
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Concurrent LED tasks on one thread with the C++20 coroutine layer.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * One task per RGB LED on four chips sets its colour, fades its brightness up
+ * and reads it back. Transfers complete through the HAL callbacks from
+ * Sim_Complete(), Poll() resumes the tasks like a main loop would.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#include "LP5024_Coro.hpp"
+#include "LP5024_Test.h"
+
+#define LP5024_TEST_CHIPS (4)
+#define LP5024_TEST_TASKS (LP5024_TEST_CHIPS * LP5024_RGBLED_COUNT)
+
+/**
+ * @brief Fire and forget task, runs until its first await at once.
+ */
+struct Task
+{
+	struct promise_type
+	{
+		Task get_return_object() { return {}; }
+		std::suspend_never initial_suspend() { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() {}
+	};
+};
+
+static I2C_HandleTypeDef hi2c;
+static lp5024::coro::Bus bus(&hi2c);
+static uint16_t finished;
+static uint8_t results[LP5024_TEST_TASKS];
+static uint8_t readback[LP5024_TEST_TASKS];
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	bus.TxCpltCallback(hi2c);
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	bus.RxCpltCallback(hi2c);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+	bus.ErrorCallback(hi2c);
+}
+
+/* Colour, fade and read back of one LED. */
+static Task LP5024_Test_Led(lp5024_Device_t *device, uint8_t led, uint16_t task)
+{
+	uint8_t colour[3] = {(uint8_t)task, (uint8_t)(2 * task), (uint8_t)(3 * task)};
+	uint8_t status = co_await bus.Write(device, LP5024_REG_BRIGHT_LED_0 + led * 3, colour, 3);
+	status |= co_await bus.Fade(device, led, 0, 255, 10 + led);
+	status |= co_await bus.Read(device, LP5024_REG_BRIGHT_RGB_0 + led, &readback[task], 1);
+	results[task] = status;
+	finished++;
+}
+
+/* Single write of one RGBx brightness. */
+static Task LP5024_Test_Write(lp5024_Device_t *device, uint8_t *value, uint8_t *result)
+{
+	*result = co_await bus.Write(device, LP5024_REG_BRIGHT_RGB_0, value, 1);
+	finished++;
+}
+
+/* Fade of an LED the part does not have. */
+static Task LP5024_Test_InvalidFade(lp5024_Device_t *device, uint8_t *result)
+{
+	*result = co_await bus.Fade(device, LP5024_RGBLED_COUNT, 0, 255, 10);
+	finished++;
+}
+
+/* Polls like a main loop, one millisecond per round. */
+static uint32_t LP5024_Test_Run(uint32_t limit)
+{
+	uint32_t rounds = 0;
+	while (bus.IsBusy() && rounds < limit)
+	{
+		bus.Poll();
+		while (Sim_Complete(&hi2c))
+		{
+		}
+		Sim_Advance(1);
+		rounds++;
+	}
+	return rounds;
+}
+
+int main()
+{
+	lp5024_Device_t chips[LP5024_TEST_CHIPS] = {
+		{&hi2c, LP5024_A1_GND_A0_GND, nullptr, nullptr, nullptr, nullptr},
+		{&hi2c, LP5024_A1_GND_A0_VDD, nullptr, nullptr, nullptr, nullptr},
+		{&hi2c, LP5024_A1_VDD_A0_GND, nullptr, nullptr, nullptr, nullptr},
+		{&hi2c, LP5024_A1_VDD_A0_VDD, nullptr, nullptr, nullptr, nullptr}};
+	uint32_t fadeWrites = 0;
+	uint32_t rounds;
+	uint8_t value = 0;
+	uint8_t result = HAL_OK;
+	Sim_Stats_t stats;
+
+	Sim_Reset();
+	for (uint16_t task = 0; task < LP5024_TEST_TASKS; task++)
+	{
+		LP5024_Test_Led(&chips[task / LP5024_RGBLED_COUNT], task % LP5024_RGBLED_COUNT, task);
+		fadeWrites += 10 + task % LP5024_RGBLED_COUNT + 1;
+	}
+	/* Only the first transfer runs, all tasks wait on the bus. */
+	LP5024_TEST_CHECK(finished == 0 && Sim_Pending(&hi2c) == 1 + 3);
+	rounds = LP5024_Test_Run(1000);
+	Sim_GetStats(&hi2c, &stats, 1);
+	LP5024_TEST_CHECK(finished == LP5024_TEST_TASKS && !bus.IsBusy());
+	for (uint16_t task = 0; task < LP5024_TEST_TASKS; task++)
+	{
+		const uint8_t *reg = Sim_Registers(&hi2c, 0x28 + task / LP5024_RGBLED_COUNT);
+		uint8_t led = task % LP5024_RGBLED_COUNT;
+		LP5024_TEST_CHECK(results[task] == HAL_OK && readback[task] == 255);
+		LP5024_TEST_CHECK(reg[LP5024_REG_BRIGHT_RGB_0 + led] == 255);
+		LP5024_TEST_CHECK(reg[LP5024_REG_BRIGHT_LED_0 + led * 3] == (uint8_t)task && reg[LP5024_REG_BRIGHT_LED_0 + led * 3 + 2] == (uint8_t)(3 * task));
+	}
+	/* One transfer at a time, no blocking call, at most one fade write per tick. */
+	LP5024_TEST_CHECK(stats.overlaps == 0 && stats.blocking == 0);
+	LP5024_TEST_CHECK(stats.reads == LP5024_TEST_TASKS);
+	LP5024_TEST_CHECK(stats.writes > LP5024_TEST_TASKS && stats.writes <= LP5024_TEST_TASKS + fadeWrites);
+	printf("%u tasks finished in %u ms, %u writes and %u reads\n", (unsigned)finished, (unsigned)rounds, (unsigned)stats.writes, (unsigned)stats.reads);
+
+	/* A bus error reaches the awaiting task through HAL_I2C_ErrorCallback. */
+	finished = 0;
+	Sim_InjectFault(&hi2c, HAL_ERROR, 1);
+	LP5024_Test_Write(&chips[0], &value, &result);
+	LP5024_Test_Run(10);
+	LP5024_TEST_CHECK(finished == 1 && result == HAL_ERROR);
+	LP5024_TEST_CHECK(Sim_Registers(&hi2c, 0x28)[LP5024_REG_BRIGHT_RGB_0] == 255);
+
+	/* Invalid LED completes without bus access. */
+	Sim_GetStats(&hi2c, &stats, 1);
+	LP5024_Test_InvalidFade(&chips[0], &result);
+	LP5024_Test_Run(10);
+	Sim_GetStats(&hi2c, &stats, 1);
+	LP5024_TEST_CHECK(finished == 2 && result == LP5024_INPUTOUTOFRANGE && stats.writes == 0);
+	return LP5024_TEST_RESULT();
+}
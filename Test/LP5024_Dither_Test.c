@@ -0,0 +1,89 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Dither_Test.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Temporal dithering checked on the simulated OUTx registers.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Over 256 sent frames the OUTx registers have to add up to the 16 bit value
+ * of their channel, every single frame within one step of it. Bus load is
+ * derived from the traffic of the simulated bus.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#include "LP5024_Dither.h"
+#include "LP5024_Test.h"
+
+/* Start, stop and acknowledge bits around address and register byte. */
+#define LP5024_TEST_FRAME_OVERHEAD (20)
+
+static I2C_HandleTypeDef hi2c;
+static lp5024_Pipeline_t pipeline;
+static lp5024_Dither_t dither;
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	LP5024_Pipeline_TxCpltCallback(&pipeline, hi2c);
+}
+
+int main(void)
+{
+	static const uint16_t values[LP5024_LED_COUNT] = {
+		0x0000, 0x0001, 0x00FF, 0x0100, 0x0140, 0x0180, 0x01FF, 0x7FFF,
+		0x8000, 0x8080, 0xFEFF, 0xFF00, 0xFF7F, 0xFFFF, 0x1234, 0x4321,
+		LP5024_DITHER_FROM_12BIT(0x001), LP5024_DITHER_FROM_12BIT(0x010), LP5024_DITHER_FROM_12BIT(0x0FF),
+		LP5024_DITHER_FROM_12BIT(0x100), LP5024_DITHER_FROM_12BIT(0x7FF), LP5024_DITHER_FROM_12BIT(0xABC),
+		LP5024_DITHER_FROM_12BIT(0xFFE), LP5024_DITHER_FROM_12BIT(0xFFF)};
+	lp5024_Device_t device = {&hi2c, LP5024_A1_GND_A0_GND, NULL, NULL, NULL, NULL};
+	uint32_t sum[LP5024_LED_COUNT] = {0};
+	const uint8_t *out;
+	Sim_Stats_t bus;
+	uint32_t bits;
+
+	Sim_Reset();
+	out = &Sim_Registers(&hi2c, 0x28)[LP5024_REG_BRIGHT_LED_0];
+	LP5024_TEST_CHECK(LP5024_Pipeline_Init(&pipeline, &device, LP5024_RGB) == LP5024_SUCCESS);
+	LP5024_Dither_Init(&dither, &pipeline);
+	for (uint8_t led = 0; led < LP5024_RGBLED_COUNT; led++)
+	{
+		LP5024_TEST_CHECK(LP5024_Dither_SetLEDColourRGB(&dither, led, values[led * 3], values[led * 3 + 1], values[led * 3 + 2]) == LP5024_SUCCESS);
+	}
+	LP5024_TEST_CHECK(LP5024_Dither_SetLEDColourRGB(&dither, LP5024_RGBLED_COUNT, 0, 0, 0) == LP5024_INPUTOUTOFRANGE);
+
+	Sim_GetStats(&hi2c, &bus, 1);
+	for (uint16_t frame = 0; frame < 256; frame++)
+	{
+		LP5024_TEST_CHECK(LP5024_Dither_Render(&dither) == HAL_OK);
+		while (Sim_Complete(&hi2c))
+		{
+		}
+		for (uint8_t channel = 0; channel < LP5024_LED_COUNT; channel++)
+		{
+			uint8_t floor = values[channel] >> 8;
+			LP5024_TEST_CHECK(out[channel] == floor || (out[channel] == floor + 1 && floor < 0xFF));
+			sum[channel] += out[channel];
+		}
+	}
+	Sim_GetStats(&hi2c, &bus, 1);
+	for (uint8_t channel = 0; channel < LP5024_LED_COUNT; channel++)
+	{ /* Full scale can not be exceeded, its fraction is lost. */
+		uint32_t expected = (values[channel] >= 0xFF00) ? (uint32_t)(values[channel] >> 8) * 256 : values[channel];
+		LP5024_TEST_CHECK(sum[channel] == expected);
+	}
+	LP5024_TEST_CHECK(bus.writes == 256 && bus.bytes == 256 * LP5024_LED_COUNT);
+
+	/* A frame the pipeline can not take does not advance the accumulators. */
+	while (LP5024_Dither_Render(&dither) == HAL_OK)
+	{
+	}
+	uint32_t frames = dither.frames;
+	LP5024_TEST_CHECK(LP5024_Dither_Render(&dither) == HAL_BUSY && dither.frames == frames);
+
+	bits = LP5024_TEST_FRAME_OVERHEAD + 9 * bus.bytes / bus.writes;
+	printf("%u bit per frame, max. %u frames/s at 100 kHz, %u frames/s at 400 kHz\n",
+		   (unsigned)bits, (unsigned)(100000 / bits), (unsigned)(400000 / bits));
+	printf("12 bit at 60 Hz needs %u frames/s, %.0f %% load at 400 kHz\n", 16 * 60, 16 * 60 * bits * 100.0 / 400000);
+	return LP5024_TEST_RESULT();
+}
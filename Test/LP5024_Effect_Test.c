@@ -0,0 +1,160 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Effect_Test.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Procedural effects checked tick by tick on the simulated timestamp.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Breathe, chase, sparkle and strobe are advanced with Sim_Advance(), so every
+ * frame is deterministic. Sparkle is predicted with its own copy of the LFSR.
+ * The cost of a tick is printed per LED.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#include "LP5024_Effect.h"
+#include "LP5024_Test.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define LP5024_TEST_LEDS (64)
+#define LP5024_TEST_ROUNDS (20000)
+
+static uint8_t image[LP5024_TEST_LEDS * 3];
+static uint8_t mirror[LP5024_TEST_LEDS * 3];
+
+/* Level of an LED, red channel of an RGB image rendered with full red. */
+static uint8_t LP5024_Test_Level(uint16_t led)
+{
+	return image[led * 3];
+}
+
+int main(void)
+{
+	lp5024_Effect_t effect, twin;
+	lp5024_EffectStats_t statistics;
+	uint8_t previous, expected[LP5024_TEST_LEDS];
+	uint8_t levels[256]; // Level of every tick of one period.
+	uint16_t lfsr = 0xACE1;
+	uint16_t on = 0;
+	uint64_t start;
+
+	/* Breathe: dark at the start of a period, full at half, rising in between, symmetric. */
+	LP5024_TEST_CHECK(LP5024_Effect_InitBreathe(&effect, 255, 128, 0, 256, LP5024_WaveSine, 0) == LP5024_SUCCESS);
+	previous = 0;
+	for (uint16_t t = 0; t < 256; t++)
+	{
+		LP5024_Effect_Tick(&effect, image, 1, LP5024_RGB);
+		levels[t] = LP5024_Test_Level(0);
+		LP5024_TEST_CHECK(image[2] == 0 && abs(image[1] - (levels[t] >> 1)) <= 1);
+		if (t > 0 && t <= 128)
+		{
+			LP5024_TEST_CHECK(levels[t] >= previous);
+		}
+		previous = levels[t];
+		Sim_Advance(1);
+	}
+	LP5024_TEST_CHECK(levels[0] == 0 && levels[129] == 255);
+	/* Angle is one behind the tick, as the phase increment is rounded down. */
+	for (uint16_t angle = 2; angle < 128; angle++)
+	{
+		LP5024_TEST_CHECK(abs(levels[1 + angle] - levels[257 - angle]) <= 1);
+	}
+
+	/* Triangle is linear, a spread of a quarter turn shifts neighbours by a quarter period. */
+	LP5024_Effect_InitBreathe(&effect, 255, 0, 0, 256, LP5024_WaveTriangle, 64);
+	Sim_Advance(33);
+	LP5024_Effect_Tick(&effect, image, 3, LP5024_RGB);
+	LP5024_TEST_CHECK(LP5024_Test_Level(0) == 64 && LP5024_Test_Level(1) == 192 && LP5024_Test_Level(2) == 190);
+
+	/* Chase: head at full level, tail fading over width LEDs, one LED on per period / count. */
+	LP5024_TEST_CHECK(LP5024_Effect_InitChase(&effect, 255, 0, 0, 800, 4) == LP5024_SUCCESS);
+	for (uint16_t step = 0; step < 10; step++)
+	{
+		Sim_Advance(step == 0 ? 50 : 100);
+		LP5024_Effect_Tick(&effect, image, 8, LP5024_RGB);
+		uint8_t head = step % 8;
+		for (uint8_t distance = 0; distance < 8; distance++)
+		{
+			uint8_t level = (distance < 4) ? 255 - distance * 64 : 0;
+			LP5024_TEST_CHECK(LP5024_Test_Level((head + 8 - distance) % 8) == level);
+		}
+	}
+
+	/* Strobe: on for duty / 256 of the period, all LEDs alike and in colour order. */
+	LP5024_TEST_CHECK(LP5024_Effect_InitStrobe(&effect, 10, 20, 30, 256, 64) == LP5024_SUCCESS);
+	for (uint16_t t = 0; t < 256; t++)
+	{
+		LP5024_Effect_Tick(&effect, image, 4, LP5024_BGR);
+		on += image[2] == 10;
+		LP5024_TEST_CHECK(image[0] == image[9] && image[1] == image[10] && image[2] == image[11]);
+		LP5024_TEST_CHECK((image[0] == 30 && image[1] == 20) || (image[0] == 0 && image[1] == 0 && image[2] == 0));
+		Sim_Advance(1);
+	}
+	LP5024_TEST_CHECK(on >= 64 && on <= 65);
+
+	/* Sparkle: every new sparkle and every decay step predicted with a copy of the LFSR. */
+	memset(image, 0, sizeof(image));
+	memset(expected, 0, sizeof(expected));
+	LP5024_TEST_CHECK(LP5024_Effect_InitSparkle(&effect, 255, 0, 0, 16, 64, 0xACE1) == LP5024_SUCCESS);
+	for (uint16_t t = 0; t < 200; t++)
+	{
+		LP5024_Effect_Tick(&effect, image, LP5024_TEST_LEDS, LP5024_RGB);
+		for (uint16_t led = 0; led < LP5024_TEST_LEDS; led++)
+		{
+			lfsr = (lfsr >> 1) ^ (-(lfsr & 1u) & 0xB400u);
+			expected[led] = ((uint8_t)lfsr < 16) ? 255 : (uint8_t)((expected[led] * 192) >> 8);
+			LP5024_TEST_CHECK(LP5024_Test_Level(led) == expected[led]);
+		}
+	}
+	/* Same seed, same sparkles. */
+	LP5024_Effect_InitSparkle(&effect, 255, 255, 255, 40, 32, 7);
+	LP5024_Effect_InitSparkle(&twin, 255, 255, 255, 40, 32, 7);
+	memset(image, 0, sizeof(image));
+	memset(mirror, 0, sizeof(mirror));
+	for (uint16_t t = 0; t < 50; t++)
+	{
+		LP5024_Effect_Tick(&effect, image, LP5024_TEST_LEDS, LP5024_RGB);
+		LP5024_Effect_Tick(&twin, mirror, LP5024_TEST_LEDS, LP5024_RGB);
+	}
+	LP5024_TEST_CHECK(memcmp(image, mirror, sizeof(image)) == 0 && effect.lfsr == twin.lfsr);
+
+	LP5024_TEST_CHECK(LP5024_Effect_InitBreathe(&effect, 1, 1, 1, 0, LP5024_WaveSine, 0) == LP5024_INPUTOUTOFRANGE);
+	LP5024_TEST_CHECK(LP5024_Effect_InitBreathe(&effect, 1, 1, 1, 1, LP5024_WaveTriangle + 1, 0) == LP5024_INPUTOUTOFRANGE);
+	LP5024_TEST_CHECK(LP5024_Effect_InitChase(&effect, 1, 1, 1, 100, 0) == LP5024_INPUTOUTOFRANGE);
+	LP5024_TEST_CHECK(LP5024_Effect_InitSparkle(&effect, 1, 1, 1, 1, 1, 0) == LP5024_INPUTOUTOFRANGE);
+	LP5024_TEST_CHECK(LP5024_Effect_Tick(&twin, image, 1, LP5024_BRG + 1) == LP5024_INPUTOUTOFRANGE);
+
+	/* Cost per LED and tick of every effect on 64 LEDs. */
+	static const char *const names[4] = {"breathe", "chase", "sparkle", "strobe"};
+	for (uint8_t type = LP5024_EffectBreathe; type <= LP5024_EffectStrobe; type++)
+	{
+		switch (type)
+		{
+		case LP5024_EffectBreathe:
+			LP5024_Effect_InitBreathe(&effect, 200, 100, 50, 1000, LP5024_WaveSine, 8);
+			break;
+		case LP5024_EffectChase:
+			LP5024_Effect_InitChase(&effect, 255, 0, 0, 800, 6);
+			break;
+		case LP5024_EffectSparkle:
+			LP5024_Effect_InitSparkle(&effect, 255, 255, 255, 16, 64, 1);
+			break;
+		default:
+			LP5024_Effect_InitStrobe(&effect, 9, 9, 9, 100, 64);
+			break;
+		}
+		start = LP5024_Test_Nanoseconds();
+		for (uint32_t round = 0; round < LP5024_TEST_ROUNDS; round++)
+		{
+			Sim_Advance(1);
+			LP5024_Effect_Tick(&effect, image, LP5024_TEST_LEDS, LP5024_GRB);
+		}
+		double ns = (double)(LP5024_Test_Nanoseconds() - start) / ((double)LP5024_TEST_ROUNDS * LP5024_TEST_LEDS);
+		LP5024_Effect_GetStats(&effect, &statistics, 1);
+		LP5024_TEST_CHECK(statistics.ticks == LP5024_TEST_ROUNDS && statistics.leds == LP5024_TEST_ROUNDS * LP5024_TEST_LEDS);
+		printf("%s: %.2f ns per LED and tick\n", names[type], ns);
+	}
+	return LP5024_TEST_RESULT();
+}
@@ -0,0 +1,111 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Gradient_Test.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Integer gradients against the HSB setters of the driver.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Rainbows have to hit the primaries exactly, match HSVtoRGB within rounding
+ * on its sector edges and rotate by whole LEDs. Linear gradients have to start and end on their
+ * stops. A rotating rainbow is timed against the per LED HSB path.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#include "LP5024_Gradient.h"
+#include "LP5024_Test.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define LP5024_TEST_ROUNDS (10000)
+
+static I2C_HandleTypeDef hi2c;
+
+static uint8_t LP5024_Test_IsColour(const uint8_t *led, uint8_t red, uint8_t green, uint8_t blue, uint8_t tolerance)
+{
+	return abs(led[0] - red) <= tolerance && abs(led[1] - green) <= tolerance && abs(led[2] - blue) <= tolerance;
+}
+
+int main(void)
+{
+	static const uint8_t primaries[6][3] = {{255, 0, 0}, {255, 255, 0}, {0, 255, 0}, {0, 255, 255}, {0, 0, 255}, {255, 0, 255}};
+	static const uint8_t stops[9] = {255, 0, 0, 0, 255, 0, 0, 0, 255};
+	const lp5024_ChannelMap_t *rgb = &LP5024_ChannelMaps[LP5024_RGB];
+	lp5024_Device_t chips[2] = {{&hi2c, LP5024_A1_GND_A0_GND, NULL, NULL, NULL, NULL}, {&hi2c, LP5024_A1_GND_A0_VDD, NULL, NULL, NULL, NULL}};
+	uint8_t frame[2 * LP5024_LED_COUNT];
+	uint8_t rotated[2 * LP5024_LED_COUNT];
+	uint8_t red, green, blue;
+	Sim_Stats_t bus;
+	uint64_t start, perLED, gradient;
+
+	/* Primaries at multiples of 60 degrees. */
+	LP5024_TEST_CHECK(LP5024_Gradient_Rainbow(frame, rgb, 6, 0, 360, 100, 100) == LP5024_SUCCESS);
+	for (uint8_t led = 0; led < 6; led++)
+	{
+		LP5024_TEST_CHECK(LP5024_Test_IsColour(&frame[led * 3], primaries[led][0], primaries[led][1], primaries[led][2], 0));
+	}
+
+	/* HSVtoRGB switches x per 60 degree sector, so both paths are compared on the sector edges. */
+	for (uint8_t saturation = 0; saturation <= 100; saturation += 25)
+	{
+		for (uint8_t brightness = 0; brightness <= 100; brightness += 25)
+		{
+			LP5024_TEST_CHECK(LP5024_Gradient_Rainbow(frame, rgb, 6, 0, 360, saturation, brightness) == LP5024_SUCCESS);
+			for (uint8_t led = 0; led < 6; led++)
+			{
+				HSVtoRGB(&red, &green, &blue, 60 * led, saturation, brightness);
+				LP5024_TEST_CHECK(LP5024_Test_IsColour(&frame[led * 3], red, green, blue, 3));
+			}
+		}
+	}
+
+	/* Rotating by 45 degrees moves every colour one LED on, across two chips as one ring. */
+	LP5024_TEST_CHECK(LP5024_Gradient_Rainbow(frame, rgb, 2 * LP5024_RGBLED_COUNT, 0, 360, 100, 100) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(LP5024_Gradient_Rainbow(rotated, rgb, LP5024_RGBLED_COUNT, 45, 180, 100, 100) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(memcmp(&frame[2 * 3], rotated, LP5024_LED_COUNT) == 0);
+
+	/* Colour order is applied per LED. */
+	LP5024_TEST_CHECK(LP5024_Gradient_Rainbow(frame, &LP5024_ChannelMaps[LP5024_BRG], 2, 60, 120, 100, 100) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(LP5024_Test_IsColour(&frame[0], 0, 255, 255, 0) && LP5024_Test_IsColour(&frame[3], 0, 0, 255, 0));
+
+	/* Linear through three stops, ends and middle on the stops. */
+	LP5024_TEST_CHECK(LP5024_Gradient_Linear(frame, rgb, 9, 0, stops, 3) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(LP5024_Test_IsColour(&frame[0], 255, 0, 0, 0));
+	LP5024_TEST_CHECK(LP5024_Test_IsColour(&frame[4 * 3], 0, 255, 0, 0));
+	LP5024_TEST_CHECK(LP5024_Test_IsColour(&frame[8 * 3], 0, 0, 255, 0));
+	LP5024_TEST_CHECK(LP5024_Test_IsColour(&frame[2 * 3], 128, 127, 0, 1));
+	memcpy(rotated, frame, 9 * 3);
+	LP5024_TEST_CHECK(LP5024_Gradient_Linear(frame, rgb, 9, 2, stops, 3) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(memcmp(&frame[2 * 3], rotated, 7 * 3) == 0 && memcmp(frame, &rotated[7 * 3], 2 * 3) == 0);
+	LP5024_TEST_CHECK(LP5024_Gradient_Linear(frame, rgb, 9, 0, stops, 1) == LP5024_INPUTOUTOFRANGE);
+	LP5024_TEST_CHECK(LP5024_Gradient_Rainbow(frame, rgb, 8, 360, 360, 100, 100) == LP5024_INPUTOUTOFRANGE);
+
+	/* Rotating rainbow on two chips, per LED HSB setters against one gradient and a burst per chip. */
+	Sim_Reset();
+	Sim_GetStats(&hi2c, &bus, 1);
+	start = LP5024_Test_Nanoseconds();
+	for (uint32_t round = 0; round < LP5024_TEST_ROUNDS; round++)
+	{
+		for (uint8_t led = 0; led < 2 * LP5024_RGBLED_COUNT; led++)
+		{
+			LP5024_SetLEDColourHSB(&chips[led / LP5024_RGBLED_COUNT], LP5024_RGB, led % LP5024_RGBLED_COUNT, (round + led * 360 / 16) % 360, 100, 100);
+		}
+	}
+	perLED = LP5024_Test_Nanoseconds() - start;
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(bus.writes == LP5024_TEST_ROUNDS * 2 * LP5024_LED_COUNT);
+	start = LP5024_Test_Nanoseconds();
+	for (uint32_t round = 0; round < LP5024_TEST_ROUNDS; round++)
+	{
+		LP5024_Gradient_Rainbow(frame, rgb, 2 * LP5024_RGBLED_COUNT, round % 360, 360, 100, 100);
+		LP5024_WriteRegisters(&chips[0], LP5024_REG_BRIGHT_LED_0, frame, LP5024_LED_COUNT);
+		LP5024_WriteRegisters(&chips[1], LP5024_REG_BRIGHT_LED_0, &frame[LP5024_LED_COUNT], LP5024_LED_COUNT);
+	}
+	gradient = LP5024_Test_Nanoseconds() - start;
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(bus.writes == LP5024_TEST_ROUNDS * 2);
+	printf("rotating rainbow of 16 LEDs: per LED HSB %.0f ns and %u writes, gradient %.0f ns and 2 writes per frame\n",
+		   (double)perLED / LP5024_TEST_ROUNDS, 2 * LP5024_LED_COUNT, (double)gradient / LP5024_TEST_ROUNDS);
+	return LP5024_TEST_RESULT();
+}
@@ -0,0 +1,108 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Hpp_Test.cpp
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Test of the C++ layer against the C API, built as C++11.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * The compile time colour permutations have to match LP5024_ChannelMaps and
+ * every bus backend has to leave the same registers as the C API.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#include "LP5024.hpp"
+#include "LP5024_Test.h"
+#include <cstring>
+
+static_assert(lp5024::Device<LP5024_A1_VDD_A0_GND>::address == (0x28 + 2) << 1, "address");
+static_assert(lp5024::RegisterMap<LP5024_RGBLED_7>::out == LP5024_REG_BRIGHT_LED_0 + 21, "OUTx map");
+static_assert(lp5024::RegisterMap<LP5024_RGBLED_7>::brightness == LP5024_REG_BRIGHT_RGB_7, "RGBx map");
+
+static I2C_HandleTypeDef hi2c;
+
+/* Compares the compile time permutation of an order with the table of the C API. */
+template <lp5024_ColorOrder_t Order>
+static bool LP5024_Test_SameMap()
+{
+	using Map = lp5024::ChannelMap<Order>;
+	return Map::red == LP5024_ChannelMaps[Order].red && Map::green == LP5024_ChannelMaps[Order].green && Map::blue == LP5024_ChannelMaps[Order].blue;
+}
+
+/* Renders the same pattern through the C++ layer and checks the chip against the C API. */
+template <class Bus>
+static void LP5024_Test_Backend(const char *name)
+{
+	lp5024::Device<LP5024_A1_GND_A0_VDD, LP5024_GRB, Bus> leds(&hi2c);
+	lp5024_Device_t device = {&hi2c, LP5024_A1_GND_A0_GND, nullptr, nullptr, nullptr, nullptr};
+	uint8_t brightness[LP5024_RGBLED_COUNT] = {8, 7, 6, 5, 4, 3, 2, 1};
+	Sim_Stats_t bus;
+
+	Sim_Reset();
+	for (uint8_t led = 0; led < LP5024_RGBLED_COUNT; led++)
+	{
+		LP5024_SetLEDColourRGB(&device, LP5024_GRB, led, led, 2 * led, 3 * led);
+		LP5024_TEST_CHECK(leds.SetLEDColourRGB(led, led, 2 * led, 3 * led) == LP5024_SUCCESS);
+	}
+	LP5024_SetLEDColourHSB(&device, LP5024_GRB, 6, 120, 50, 80);
+	LP5024_TEST_CHECK(leds.SetLEDColourHSB(6, 120, 50, 80) == LP5024_SUCCESS);
+	LP5024_SetLEDColourRGB(&device, LP5024_GRB, LP5024_RGBLED_1, 9, 9, 1);
+	leds.template SetLEDColourRGB<LP5024_RGBLED_1>(9, 9, 1);
+	LP5024_SetAllRGBLEDBrightness(&device, brightness);
+	LP5024_TEST_CHECK(leds.SetLEDColourRGB(LP5024_RGBLED_COUNT, 0, 0, 0) == LP5024_INPUTOUTOFRANGE);
+
+	Sim_GetStats(&hi2c, &bus, 1);
+	/* DmaBus takes one transfer at a time, so each write is completed before the next. */
+	LP5024_TEST_CHECK(leds.Flush() == HAL_OK);
+	Sim_Complete(&hi2c);
+	LP5024_TEST_CHECK(leds.SetRGBLEDBrightness(brightness) == HAL_OK);
+	Sim_Complete(&hi2c);
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(bus.writes == 2 && bus.bytes == LP5024_LED_COUNT + LP5024_RGBLED_COUNT);
+	LP5024_TEST_CHECK(std::memcmp(Sim_Registers(&hi2c, 0x29), Sim_Registers(&hi2c, 0x28), LP5024_REG_COUNT) == 0);
+	printf("%s: matches C API\n", name);
+}
+
+int main()
+{
+	lp5024::Device<LP5024_A1_GND_A0_GND, LP5024_BGR, lp5024::BlockingBus> leds(&hi2c);
+	lp5024_Device_t device = {&hi2c, LP5024_A1_GND_A0_GND, nullptr, nullptr, nullptr, nullptr};
+	uint8_t colours[LP5024_LED_COUNT] = {};
+	uint64_t start;
+	const uint32_t rounds = 100000;
+
+	LP5024_TEST_CHECK(LP5024_Test_SameMap<LP5024_RGB>());
+	LP5024_TEST_CHECK(LP5024_Test_SameMap<LP5024_RBG>());
+	LP5024_TEST_CHECK(LP5024_Test_SameMap<LP5024_GRB>());
+	LP5024_TEST_CHECK(LP5024_Test_SameMap<LP5024_GBR>());
+	LP5024_TEST_CHECK(LP5024_Test_SameMap<LP5024_BGR>());
+	LP5024_TEST_CHECK(LP5024_Test_SameMap<LP5024_BRG>());
+
+	LP5024_Test_Backend<lp5024::DriverBus>("DriverBus");
+	LP5024_Test_Backend<lp5024::BlockingBus>("BlockingBus");
+	LP5024_Test_Backend<lp5024::DmaBus>("DmaBus");
+
+	/* Frame of 8 LEDs plus flush, C batch API against the template layer. */
+	start = LP5024_Test_Nanoseconds();
+	for (uint32_t round = 0; round < rounds; round++)
+	{
+		for (uint8_t led = 0; led < LP5024_RGBLED_COUNT; led++)
+		{
+			colours[led * 3] = (uint8_t)round;
+		}
+		LP5024_SetLEDColoursRGB(&device, LP5024_BGR, 0, LP5024_RGBLED_COUNT, colours);
+	}
+	printf("C API: %.1f ns per frame\n", (double)(LP5024_Test_Nanoseconds() - start) / rounds);
+	start = LP5024_Test_Nanoseconds();
+	for (uint32_t round = 0; round < rounds; round++)
+	{
+		for (uint8_t led = 0; led < LP5024_RGBLED_COUNT; led++)
+		{
+			leds.SetLEDColourRGB(led, (uint8_t)round, 0, 0);
+		}
+		leds.Flush();
+	}
+	printf("C++ BlockingBus: %.1f ns per frame\n", (double)(LP5024_Test_Nanoseconds() - start) / rounds);
+	return LP5024_TEST_RESULT();
+}
@@ -0,0 +1,81 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Intensity_Test.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Colour and intensity layers in OUTx and RGBx_BRIGHTNESS registers.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * A brightness sweep of all 8 RGB LEDs in 11 steps, once by rewriting the
+ * colour with LP5024_SetLEDColourHSB and once through the RGBx_BRIGHTNESS
+ * registers with the colour left in place.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#include "LP5024.h"
+#include "LP5024_Test.h"
+#include <string.h>
+
+static I2C_HandleTypeDef hi2c;
+
+int main(void)
+{
+	lp5024_Device_t device = {&hi2c, LP5024_A1_GND_A0_GND, NULL, NULL, NULL, NULL};
+	uint8_t intensity[LP5024_RGBLED_COUNT];
+	uint8_t colour[LP5024_LED_COUNT];
+	uint8_t red, green, blue;
+	const uint8_t *reg;
+	Sim_Stats_t combined, layered, single;
+
+	Sim_Reset();
+	reg = Sim_Registers(&hi2c, 0x28);
+
+	/* Combined: every step rewrites three OUTx registers per LED. */
+	Sim_GetStats(&hi2c, &combined, 1);
+	for (uint8_t step = 0; step <= 100; step += 10)
+	{
+		for (uint8_t led = 0; led < LP5024_RGBLED_COUNT; led++)
+		{
+			LP5024_TEST_CHECK(LP5024_SetLEDColourHSB(&device, LP5024_GRB, led, 120, 100, step) == LP5024_SUCCESS);
+		}
+	}
+	Sim_GetStats(&hi2c, &combined, 1);
+
+	/* Layered: colour once at full brightness, every step one burst of intensities. */
+	for (uint8_t led = 0; led < LP5024_RGBLED_COUNT; led++)
+	{
+		LP5024_TEST_CHECK(LP5024_SetLEDHueSaturation(&device, LP5024_GRB, led, 30 * led, 80) == LP5024_SUCCESS);
+	}
+	memcpy(colour, &reg[LP5024_REG_BRIGHT_LED_0], LP5024_LED_COUNT);
+	HSVtoRGB(&red, &green, &blue, 30 * 3, 80, 100);
+	LP5024_TEST_CHECK(reg[LP5024_REG_BRIGHT_LED_0 + 9] == green && reg[LP5024_REG_BRIGHT_LED_0 + 10] == red && reg[LP5024_REG_BRIGHT_LED_0 + 11] == blue);
+	Sim_GetStats(&hi2c, &layered, 1);
+	for (uint8_t step = 0; step <= 100; step += 10)
+	{
+		for (uint8_t led = 0; led < LP5024_RGBLED_COUNT; led++)
+		{
+			intensity[led] = step * 255 / 100;
+		}
+		LP5024_TEST_CHECK(LP5024_SetAllRGBLEDBrightness(&device, intensity) == LP5024_SUCCESS);
+		LP5024_TEST_CHECK(memcmp(&reg[LP5024_REG_BRIGHT_RGB_0], intensity, LP5024_RGBLED_COUNT) == 0);
+	}
+	Sim_GetStats(&hi2c, &layered, 1);
+	/* Intensity never touched the colour. */
+	LP5024_TEST_CHECK(memcmp(&reg[LP5024_REG_BRIGHT_LED_0], colour, LP5024_LED_COUNT) == 0);
+	LP5024_TEST_CHECK(combined.writes == 11 * LP5024_LED_COUNT && combined.bytes == 11 * LP5024_LED_COUNT);
+	LP5024_TEST_CHECK(layered.writes == 11 && layered.bytes == 11 * LP5024_RGBLED_COUNT);
+
+	/* Single LED intensity is one byte, the colour stays. */
+	LP5024_TEST_CHECK(LP5024_SetRGBLEDBrightness(&device, LP5024_RGBLED_5, 42) == LP5024_SUCCESS);
+	Sim_GetStats(&hi2c, &single, 1);
+	LP5024_TEST_CHECK(single.writes == 1 && single.bytes == 1 && reg[LP5024_REG_BRIGHT_RGB_5] == 42);
+	LP5024_TEST_CHECK(memcmp(&reg[LP5024_REG_BRIGHT_LED_0], colour, LP5024_LED_COUNT) == 0);
+
+	LP5024_TEST_CHECK(LP5024_SetLEDHueSaturation(&device, LP5024_RGB, 0, 360, 0) == LP5024_INPUTOUTOFRANGE);
+	LP5024_TEST_CHECK(LP5024_SetLEDHueSaturation(&device, LP5024_RGB, LP5024_RGBLED_COUNT, 0, 0) == LP5024_INPUTOUTOFRANGE);
+
+	printf("sweep of 8 LEDs in 11 steps: combined %u bytes in %u writes, layered %u bytes in %u writes\n",
+		   (unsigned)combined.bytes, (unsigned)combined.writes, (unsigned)layered.bytes, (unsigned)layered.writes);
+	return LP5024_TEST_RESULT();
+}
@@ -0,0 +1,149 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Limiter_Test.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Supply current limiter checked on the simulated registers.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * The current of the chips is recalculated from the simulated registers, so
+ * the budget is checked independently of the estimate of the limiter. Covers
+ * requests kept across frames, a frame limited inside an open staging scope
+ * and an LP5018 with all of its six LEDs in bank mode.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#include "LP5024_Limiter.h"
+#include "LP5024_Test.h"
+#include <string.h>
+
+#define LP5024_TEST_BUDGET (1000000) ///< Budget of the two LP5024 [uA].
+
+static I2C_HandleTypeDef hi2c;
+
+/* Output current of a chip with all LEDs in individual mode at 35 mA full scale [uA]. */
+static uint32_t LP5024_Test_Current(const uint8_t *reg, uint8_t rgbLEDs)
+{
+	uint64_t duty = 0;
+	for (uint8_t led = 0; led < rgbLEDs * 3; led++)
+	{
+		duty += (uint32_t)reg[LP5024_REG_BRIGHT_LED_0 + led] * reg[LP5024_REG_BRIGHT_RGB_0 + led / 3];
+	}
+	return (uint32_t)(duty * LP5024_LIMITER_CURRENT_35MA / (255 * 255));
+}
+
+/* Enables a chip at 35 mA full scale with all outputs set to a value. */
+static void LP5024_Test_Setup(lp5024_Device_t *device, lp5024_Shadow_t *shadow, uint8_t value)
+{
+	uint8_t frame[LP5024_LED_COUNT];
+	LP5024_InitShadow(shadow, LP5024_IdleStayOn, 0);
+	device->shadow = shadow;
+	LP5024_Enable(device, LP5024_EnableDevice);
+	LP5024_SetMaxCurrent(device, LP5024_MaxCurrent_35mA);
+	memset(frame, value, sizeof(frame));
+	LP5024_WriteRegisters(device, LP5024_REG_BRIGHT_LED_0, frame, LP5024_PART(device)->rgbLEDs * 3);
+}
+
+int main(void)
+{
+	lp5024_Shadow_t shadows[3];
+	lp5024_Device_t chips[2] = {{&hi2c, LP5024_A1_GND_A0_GND, NULL, NULL, NULL, NULL}, {&hi2c, LP5024_A1_GND_A0_VDD, NULL, NULL, NULL, NULL}};
+	lp5024_Device_t lp5018 = {&hi2c, LP5024_A1_VDD_A0_GND, NULL, &LP5024_Parts[LP5024_LP5018], NULL, NULL};
+	lp5024_Limiter_t limiter;
+	lp5024_LimiterStats_t statistics;
+	lp5024_Stage_t stage;
+	uint8_t frame[LP5024_LED_COUNT];
+	uint8_t bank[3] = {255, 255, 255};
+	const uint8_t *reg[2];
+	Sim_Stats_t bus;
+	uint32_t current;
+	uint64_t start;
+
+	/* Two white chips at 840 mA each share a 1 A supply. */
+	Sim_Reset();
+	LP5024_Limiter_Init(&limiter, LP5024_TEST_BUDGET);
+	for (uint8_t chip = 0; chip < 2; chip++)
+	{
+		LP5024_Test_Setup(&chips[chip], &shadows[chip], 255);
+		LP5024_TEST_CHECK(LP5024_Limiter_Add(&limiter, &chips[chip]) == LP5024_SUCCESS);
+		reg[chip] = Sim_Registers(&hi2c, 0x28 + chip);
+	}
+	LP5024_TEST_CHECK(LP5024_Limiter_Estimate(&chips[0]) == 24 * LP5024_LIMITER_CURRENT_35MA);
+	LP5024_TEST_CHECK(LP5024_Test_Current(reg[0], LP5024_RGBLED_COUNT) == 24 * LP5024_LIMITER_CURRENT_35MA);
+
+	/* One RGBx burst per chip brings the supply current just below the budget. */
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(LP5024_Limiter_Apply(&limiter) == HAL_OK);
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_Limiter_GetStats(&limiter, &statistics, 0);
+	current = LP5024_Test_Current(reg[0], LP5024_RGBLED_COUNT) + LP5024_Test_Current(reg[1], LP5024_RGBLED_COUNT);
+	LP5024_TEST_CHECK(bus.writes == 2 && bus.bytes == 2 * LP5024_RGBLED_COUNT);
+	LP5024_TEST_CHECK(current <= LP5024_TEST_BUDGET && current > LP5024_TEST_BUDGET * 99 / 100);
+	LP5024_TEST_CHECK(statistics.estimate == 2 * 24 * LP5024_LIMITER_CURRENT_35MA && statistics.current <= LP5024_TEST_BUDGET);
+	printf("limited %u uA to %u uA, RGBx %u\n", (unsigned)statistics.estimate, (unsigned)current, reg[0][LP5024_REG_BRIGHT_RGB_0]);
+
+	/* Unchanged frames cost no bus traffic. */
+	LP5024_TEST_CHECK(LP5024_Limiter_Apply(&limiter) == HAL_OK);
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(bus.writes == 0);
+
+	/* Brightness set by the application is the new request, others are scaled from their request again. */
+	LP5024_SetRGBLEDBrightness(&chips[0], LP5024_RGBLED_0, 0);
+	LP5024_Limiter_Apply(&limiter);
+	current = LP5024_Test_Current(reg[0], LP5024_RGBLED_COUNT) + LP5024_Test_Current(reg[1], LP5024_RGBLED_COUNT);
+	LP5024_TEST_CHECK(reg[0][LP5024_REG_BRIGHT_RGB_0] == 0 && reg[0][LP5024_REG_BRIGHT_RGB_1] >= reg[1][LP5024_REG_BRIGHT_RGB_0]);
+	LP5024_TEST_CHECK(current <= LP5024_TEST_BUDGET);
+	LP5024_SetRGBLEDBrightness(&chips[0], LP5024_RGBLED_0, 255);
+	LP5024_Limiter_Apply(&limiter);
+	LP5024_TEST_CHECK(memcmp(&reg[0][LP5024_REG_BRIGHT_RGB_0], &reg[1][LP5024_REG_BRIGHT_RGB_0], LP5024_RGBLED_COUNT) == 0);
+	LP5024_TEST_CHECK(reg[0][LP5024_REG_BRIGHT_RGB_0] == reg[0][LP5024_REG_BRIGHT_RGB_7]);
+
+	/* Staged frame: limited before the commit, the chip never shows it unlimited. */
+	Sim_Reset();
+	LP5024_Limiter_Init(&limiter, LP5024_TEST_BUDGET / 2);
+	LP5024_Test_Setup(&chips[0], &shadows[0], 0);
+	LP5024_Limiter_Add(&limiter, &chips[0]);
+	reg[0] = Sim_Registers(&hi2c, 0x28);
+	LP5024_TEST_CHECK(LP5024_Begin(&chips[0], &stage) == LP5024_SUCCESS);
+	memset(frame, 255, sizeof(frame));
+	LP5024_WriteRegisters(&chips[0], LP5024_REG_BRIGHT_LED_0, frame, LP5024_LED_COUNT);
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(LP5024_Limiter_Apply(&limiter) == HAL_OK);
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(bus.writes == 0 && reg[0][LP5024_REG_BRIGHT_LED_0] == 0 && reg[0][LP5024_REG_BRIGHT_RGB_0] == 255);
+	LP5024_TEST_CHECK(LP5024_Commit(&chips[0]) == HAL_OK);
+	Sim_GetStats(&hi2c, &bus, 1);
+	current = LP5024_Test_Current(reg[0], LP5024_RGBLED_COUNT);
+	LP5024_TEST_CHECK(reg[0][LP5024_REG_BRIGHT_LED_0] == 255 && current <= LP5024_TEST_BUDGET / 2 && current > LP5024_TEST_BUDGET / 2 * 99 / 100);
+	printf("staged frame limited to %u uA, sent with the commit in %u writes\n", (unsigned)current, (unsigned)bus.writes);
+
+	/* LP5018 in bank mode: the two missing LEDs do not force an RGBx burst. */
+	LP5024_Limiter_Init(&limiter, 3 * 6 * LP5024_LIMITER_CURRENT_35MA / 2);
+	LP5024_Test_Setup(&lp5018, &shadows[2], 0);
+	for (uint8_t led = 0; led < 6; led++)
+	{
+		LP5024_SetBankControl(&lp5018, led, LP5024_BankControl);
+	}
+	LP5024_WriteRegisters(&lp5018, LP5024_REG_BRIGHT_BANK_A, bank, 3);
+	LP5024_Limiter_Add(&limiter, &lp5018);
+	LP5024_TEST_CHECK(LP5024_Limiter_Estimate(&lp5018) == 3 * 6 * LP5024_LIMITER_CURRENT_35MA);
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(LP5024_Limiter_Apply(&limiter) == HAL_OK);
+	Sim_GetStats(&hi2c, &bus, 1);
+	LP5024_TEST_CHECK(bus.writes == 1 && bus.bytes == 1);
+	LP5024_TEST_CHECK(Sim_Registers(&hi2c, 0x2A)[LP5024_REG_BRIGHT_TOT] == 127);
+	LP5024_TEST_CHECK(LP5024_Limiter_Estimate(&lp5018) <= 3 * 6 * LP5024_LIMITER_CURRENT_35MA / 2);
+
+	/* Steady state cost of one frame for the two LP5024. */
+	LP5024_Limiter_Init(&limiter, LP5024_TEST_BUDGET);
+	LP5024_Limiter_Add(&limiter, &chips[0]);
+	LP5024_Limiter_Add(&limiter, &chips[1]);
+	start = LP5024_Test_Nanoseconds();
+	for (uint32_t round = 0; round < 100000; round++)
+	{
+		LP5024_Limiter_Apply(&limiter);
+	}
+	printf("steady frame of 2 chips: %.0f ns\n", (double)(LP5024_Test_Nanoseconds() - start) / 100000);
+	return LP5024_TEST_RESULT();
+}
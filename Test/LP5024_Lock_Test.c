@@ -0,0 +1,127 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Lock_Test.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Lock hook stress test with concurrent clients of one LP5024.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Eight threads share one chip. Each toggles its own bank bit in LED_CONF
+ * through read-modify-writes and stages its own RGB LED in a private scope.
+ * With a mutex installed as lock hooks no update may be lost and no two
+ * HAL calls may overlap on the bus.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#include "LP5024.h"
+#include "LP5024_Test.h"
+#include <pthread.h>
+
+#define LP5024_TEST_THREADS (8)
+#define LP5024_TEST_ROUNDS (5000)
+
+static I2C_HandleTypeDef hi2c;
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void LP5024_Test_Lock(void *context, lp5024_Device_t *device)
+{
+	(void)context;
+	(void)device;
+	pthread_mutex_lock(&mutex);
+}
+
+static void LP5024_Test_Unlock(void *context, lp5024_Device_t *device)
+{
+	(void)context;
+	(void)device;
+	pthread_mutex_unlock(&mutex);
+}
+
+/* One client, owns bank bit and RGB LED of its index. */
+static void *LP5024_Test_Client(void *argument)
+{
+	uint8_t led = (uint8_t)(uintptr_t)argument;
+	lp5024_Device_t device = {&hi2c, LP5024_A1_GND_A0_GND, NULL, NULL, NULL, NULL};
+	lp5024_Stage_t stage;
+	for (uint32_t round = 0; round < LP5024_TEST_ROUNDS; round++)
+	{
+		uint8_t value = (uint8_t)(round + led);
+		LP5024_TEST_CHECK(LP5024_SetBankControl(&device, led, (round & 1) ? LP5024_BankControl : LP5024_IndividualControl) == LP5024_SUCCESS);
+		LP5024_Begin(&device, &stage);
+		LP5024_SetLEDColourRGB(&device, LP5024_RGB, led, value, value + 1, value + 2);
+		LP5024_TEST_CHECK(LP5024_Commit(&device) == LP5024_SUCCESS);
+	}
+	return NULL;
+}
+
+/* Runs all clients, in parallel or one after the other, returns [ns]. */
+static uint64_t LP5024_Test_Run(uint8_t parallel)
+{
+	pthread_t thread[LP5024_TEST_THREADS];
+	uint64_t start = LP5024_Test_Nanoseconds();
+	for (uintptr_t i = 0; i < LP5024_TEST_THREADS; i++)
+	{
+		if (parallel)
+		{
+			pthread_create(&thread[i], NULL, LP5024_Test_Client, (void *)i);
+		}
+		else
+		{
+			LP5024_Test_Client((void *)i);
+		}
+	}
+	for (uint8_t i = 0; parallel && i < LP5024_TEST_THREADS; i++)
+	{
+		pthread_join(thread[i], NULL);
+	}
+	return LP5024_Test_Nanoseconds() - start;
+}
+
+static void LP5024_Test_CheckChip(void)
+{
+	uint8_t *reg = Sim_Registers(&hi2c, 0x28);
+	Sim_Stats_t statistics;
+	Sim_GetStats(&hi2c, &statistics, 1);
+	/* Last round of every client enabled its bank bit. */
+	LP5024_TEST_CHECK(reg[LP5024_REG_LED_CONF] == 0xFF);
+	for (uint8_t led = 0; led < LP5024_TEST_THREADS; led++)
+	{
+		uint8_t value = (uint8_t)(LP5024_TEST_ROUNDS - 1 + led);
+		LP5024_TEST_CHECK(reg[LP5024_REG_BRIGHT_LED_0 + 3 * led] == value);
+		LP5024_TEST_CHECK(reg[LP5024_REG_BRIGHT_LED_0 + 3 * led + 1] == (uint8_t)(value + 1));
+		LP5024_TEST_CHECK(reg[LP5024_REG_BRIGHT_LED_0 + 3 * led + 2] == (uint8_t)(value + 2));
+	}
+	LP5024_TEST_CHECK(statistics.overlaps == 0);
+}
+
+int main(void)
+{
+	lp5024_LockStats_t lockStatistics;
+	uint64_t plain, serial, parallel;
+
+	Sim_Reset();
+	plain = LP5024_Test_Run(0);
+	LP5024_Test_CheckChip();
+
+	LP5024_SetLockHooks(LP5024_Test_Lock, LP5024_Test_Unlock, NULL);
+	Sim_Reset();
+	serial = LP5024_Test_Run(0);
+	LP5024_Test_CheckChip();
+	LP5024_GetLockStats(&lockStatistics, 1);
+	/* Read and write of a read-modify-write share one lock, staging takes none. */
+	LP5024_TEST_CHECK(lockStatistics.locks == 2 * LP5024_TEST_THREADS * LP5024_TEST_ROUNDS);
+
+	Sim_Reset();
+	parallel = LP5024_Test_Run(1);
+	LP5024_Test_CheckChip();
+	LP5024_GetLockStats(&lockStatistics, 1);
+	LP5024_TEST_CHECK(lockStatistics.locks == 2 * LP5024_TEST_THREADS * LP5024_TEST_ROUNDS);
+
+	printf("%u clients x %u rounds: no hooks %.1f ns, mutex serial %.1f ns, mutex %u threads %.1f ns per round\n",
+		   LP5024_TEST_THREADS, LP5024_TEST_ROUNDS,
+		   (double)plain / (LP5024_TEST_THREADS * LP5024_TEST_ROUNDS),
+		   (double)serial / (LP5024_TEST_THREADS * LP5024_TEST_ROUNDS),
+		   LP5024_TEST_THREADS, (double)parallel / (LP5024_TEST_THREADS * LP5024_TEST_ROUNDS));
+	return LP5024_TEST_RESULT();
+}
@@ -0,0 +1,172 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_MultiBus_Test.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Parallel flush on two simulated buses with interleaved completions.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Four devices on one bus and two on the other. Completions of both buses
+ * arrive in pseudo random order, like interrupts of two I2C units would.
+ * One device is powered down and woken by its pipeline from the completion
+ * callbacks, without a blocking HAL call.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#include "LP5024_MultiBus.h"
+#include "LP5024_Test.h"
+#include <string.h>
+
+#define LP5024_TEST_DEVICES (6)
+
+static I2C_HandleTypeDef hi2c[2];
+static lp5024_MultiBus_t multiBus;
+static lp5024_Device_t devices[LP5024_TEST_DEVICES];
+static lp5024_Pipeline_t pipelines[LP5024_TEST_DEVICES];
+static lp5024_Shadow_t shadow;
+
+/* Devices 0, 2, 4, 5 on the first bus, 1 and 3 on the second. */
+static const uint8_t busOf[LP5024_TEST_DEVICES] = {0, 1, 0, 1, 0, 0};
+static const lp5024_A0_t a0Of[LP5024_TEST_DEVICES] = {LP5024_A1_GND_A0_GND, LP5024_A1_GND_A0_GND, LP5024_A1_GND_A0_VDD,
+													  LP5024_A1_GND_A0_VDD, LP5024_A1_VDD_A0_GND, LP5024_A1_VDD_A0_VDD};
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	LP5024_MultiBus_TxCpltCallback(&multiBus, hi2c);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+	LP5024_MultiBus_ErrorCallback(&multiBus, hi2c);
+}
+
+static uint8_t *LP5024_Test_Chip(uint8_t device)
+{
+	return Sim_Registers(devices[device].hi2c, 0x28 + devices[device].a0);
+}
+
+/* Renders a frame unique to device and round. */
+static void LP5024_Test_Render(uint8_t round)
+{
+	for (uint8_t device = 0; device < LP5024_TEST_DEVICES; device++)
+	{
+		for (uint8_t led = 0; led < LP5024_RGBLED_COUNT; led++)
+		{
+			LP5024_Pipeline_SetLEDColourRGB(&pipelines[device], led, round, device, led);
+		}
+	}
+}
+
+static uint8_t LP5024_Test_IsShown(uint8_t device, uint8_t round)
+{
+	uint8_t *reg = LP5024_Test_Chip(device);
+	for (uint8_t led = 0; led < LP5024_RGBLED_COUNT; led++)
+	{
+		const uint8_t *out = &reg[LP5024_REG_BRIGHT_LED_0 + led * 3];
+		if (out[0] != round || out[1] != device || out[2] != led)
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* Completes transfers of random buses until the flush is done, returns completions. */
+static uint32_t LP5024_Test_Interleave(uint32_t *seed)
+{
+	uint32_t completions = 0;
+	while (!LP5024_MultiBus_IsDone(&multiBus) && completions < 100)
+	{
+		*seed = *seed * 1103515245u + 12345u;
+		uint8_t bus = (*seed >> 16) & 1;
+		if (!Sim_Complete(&hi2c[bus]))
+		{
+			Sim_Complete(&hi2c[!bus]);
+		}
+		completions++;
+	}
+	return completions;
+}
+
+int main(void)
+{
+	lp5024_Pipeline_t *list[LP5024_TEST_DEVICES];
+	Sim_Stats_t bus[2];
+	uint32_t seed = 1;
+	uint32_t ticks;
+
+	Sim_Reset();
+	for (uint8_t device = 0; device < LP5024_TEST_DEVICES; device++)
+	{
+		devices[device] = (lp5024_Device_t){&hi2c[busOf[device]], a0Of[device], NULL, NULL, NULL, NULL};
+		LP5024_TEST_CHECK(LP5024_Pipeline_Init(&pipelines[device], &devices[device], LP5024_RGB) == LP5024_SUCCESS);
+		list[device] = &pipelines[device];
+	}
+	LP5024_TEST_CHECK(LP5024_MultiBus_Init(&multiBus, list, LP5024_TEST_DEVICES) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(multiBus.laneCount == 2 && multiBus.lanes[0].count == 4 && multiBus.lanes[1].count == 2);
+
+	/* Every interleaving shows every frame on every device. */
+	for (uint8_t round = 1; round <= 50; round++)
+	{
+		LP5024_Test_Render(round);
+		LP5024_TEST_CHECK(LP5024_MultiBus_Flush(&multiBus) == HAL_OK);
+		LP5024_TEST_CHECK(!LP5024_MultiBus_IsDone(&multiBus));
+		LP5024_TEST_CHECK(LP5024_MultiBus_Flush(&multiBus) == HAL_BUSY);
+		LP5024_TEST_CHECK(LP5024_Test_Interleave(&seed) == LP5024_TEST_DEVICES);
+		for (uint8_t device = 0; device < LP5024_TEST_DEVICES; device++)
+		{
+			LP5024_TEST_CHECK(LP5024_Test_IsShown(device, round));
+		}
+	}
+	LP5024_TEST_CHECK(multiBus.errors == 0);
+
+	/* One transfer per tick on each bus, both buses run in parallel. */
+	LP5024_Test_Render(60);
+	LP5024_MultiBus_Flush(&multiBus);
+	while (!LP5024_MultiBus_IsDone(&multiBus))
+	{
+		Sim_Advance(1);
+		Sim_Complete(&hi2c[0]);
+		Sim_Complete(&hi2c[1]);
+	}
+	ticks = multiBus.flushTicks;
+	LP5024_TEST_CHECK(ticks == 4);
+	LP5024_TEST_CHECK(multiBus.lanes[0].ticks == 4 && multiBus.lanes[1].ticks == 2);
+	printf("flush of %u devices: %u transfer times, %u one bus after the other\n", LP5024_TEST_DEVICES, (unsigned)ticks, LP5024_TEST_DEVICES);
+
+	/* A failed transfer skips to the next device of the lane. */
+	Sim_InjectFault(&hi2c[1], HAL_ERROR, 1);
+	LP5024_Test_Render(61);
+	LP5024_MultiBus_Flush(&multiBus);
+	LP5024_Test_Interleave(&seed);
+	LP5024_TEST_CHECK(LP5024_MultiBus_IsDone(&multiBus) && multiBus.errors == 1);
+	LP5024_TEST_CHECK(!LP5024_Test_IsShown(1, 61) && LP5024_Test_IsShown(3, 61));
+	multiBus.errors = 0;
+
+	/* Powered down device is woken from the completion callbacks. */
+	LP5024_InitShadow(&shadow, LP5024_IdleChipDisable, 10);
+	devices[3].shadow = &shadow;
+	LP5024_TEST_CHECK(LP5024_Enable(&devices[3], LP5024_EnableDevice) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(LP5024_SetLEDColoursRGB(&devices[3], LP5024_RGB, 0, LP5024_RGBLED_COUNT, (uint8_t[LP5024_LED_COUNT]){0}) == LP5024_SUCCESS);
+	Sim_Advance(10);
+	LP5024_TEST_CHECK(LP5024_IdleTick(&devices[3]) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(shadow.asleep && !(LP5024_Test_Chip(3)[LP5024_REG_ENABLE] & (0b1 << 6)));
+	Sim_GetStats(&hi2c[0], &bus[0], 1);
+	Sim_GetStats(&hi2c[1], &bus[1], 1);
+	LP5024_Test_Render(62);
+	LP5024_MultiBus_Flush(&multiBus);
+	LP5024_TEST_CHECK(LP5024_Test_Interleave(&seed) == LP5024_TEST_DEVICES + 1);
+	Sim_GetStats(&hi2c[0], &bus[0], 1);
+	Sim_GetStats(&hi2c[1], &bus[1], 1);
+	LP5024_TEST_CHECK(bus[0].blocking == 0 && bus[1].blocking == 0);
+	LP5024_TEST_CHECK(bus[1].writes == 3);
+	LP5024_TEST_CHECK(!shadow.asleep && (LP5024_Test_Chip(3)[LP5024_REG_ENABLE] & (0b1 << 6)));
+	for (uint8_t device = 0; device < LP5024_TEST_DEVICES; device++)
+	{
+		LP5024_TEST_CHECK(LP5024_Test_IsShown(device, 62));
+	}
+	LP5024_TEST_CHECK(memcmp(LP5024_Test_Chip(3), shadow.reg, LP5024_REG_COUNT) == 0);
+	LP5024_TEST_CHECK(multiBus.errors == 0);
+	return LP5024_TEST_RESULT();
+}
@@ -0,0 +1,107 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Table_Test.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Device table test with panels of 4, 16 and 64 chips.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Four chips per simulated bus. A full panel update has to cost one burst
+ * per chip, unchanged chips and settings none.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#include "LP5024_Table.h"
+#include "LP5024_Test.h"
+#include <string.h>
+
+#define LP5024_TEST_ROUNDS (1000)
+
+static I2C_HandleTypeDef hi2c[LP5024_TABLE_MAX_DEVICES / 4];
+static lp5024_DeviceTable_t table;
+
+/* Sums traffic of all buses and resets the counters. */
+static void LP5024_Test_Traffic(uint32_t *writes, uint32_t *bytes)
+{
+	Sim_Stats_t bus;
+	*writes = 0;
+	*bytes = 0;
+	for (uint8_t i = 0; i < LP5024_TABLE_MAX_DEVICES / 4; i++)
+	{
+		Sim_GetStats(&hi2c[i], &bus, 1);
+		*writes += bus.writes;
+		*bytes += bus.bytes;
+	}
+}
+
+static void LP5024_Test_Panel(uint8_t count)
+{
+	lp5024_Handle_t handle;
+	uint32_t writes, bytes;
+	uint8_t brightness[LP5024_RGBLED_COUNT] = {1, 2, 3, 4, 5, 6, 7, 8};
+	uint64_t start;
+
+	Sim_Reset();
+	LP5024_Table_Init(&table);
+	for (uint8_t chip = 0; chip < count; chip++)
+	{
+		LP5024_TEST_CHECK(LP5024_Table_Add(&table, &hi2c[chip / 4], (lp5024_A0_t)(chip % 4), &handle) == LP5024_SUCCESS);
+		LP5024_TEST_CHECK(handle == chip);
+	}
+
+	/* Range fill plus one LED, one burst per chip. */
+	LP5024_TEST_CHECK(LP5024_Table_FillRGB(&table, 0, count, LP5024_GRB, 1, 2, 3) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(LP5024_Table_SetLEDColourRGB(&table, count - 1, LP5024_RGB, 7, 9, 8, 7) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(LP5024_Table_Flush(&table, 0, count) == LP5024_SUCCESS);
+	LP5024_Test_Traffic(&writes, &bytes);
+	LP5024_TEST_CHECK(writes == count && bytes == (uint32_t)count * LP5024_LED_COUNT);
+	for (uint8_t chip = 0; chip < count; chip++)
+	{
+		const uint8_t *out = &Sim_Registers(&hi2c[chip / 4], 0x28 + chip % 4)[LP5024_REG_BRIGHT_LED_0];
+		LP5024_TEST_CHECK(out[0] == 2 && out[1] == 1 && out[2] == 3);
+		LP5024_TEST_CHECK(!LP5024_Table_IsDirty(&table, chip));
+	}
+	LP5024_TEST_CHECK(memcmp(&Sim_Registers(&hi2c[(count - 1) / 4], 0x28 + (count - 1) % 4)[LP5024_REG_BRIGHT_LED_0 + 21], (uint8_t[]){9, 8, 7}, 3) == 0);
+
+	/* Clean chips and settings cost nothing, a changed chip one burst. */
+	LP5024_TEST_CHECK(LP5024_Table_Flush(&table, 0, count) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(LP5024_Table_SetLEDColourRGB(&table, count / 2, LP5024_RGB, 0, 4, 5, 6) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(LP5024_Table_Flush(&table, 0, count) == LP5024_SUCCESS);
+	LP5024_Test_Traffic(&writes, &bytes);
+	LP5024_TEST_CHECK(writes == 1);
+	LP5024_TEST_CHECK(LP5024_Table_SetRGBLEDBrightness(&table, 0, count, brightness) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(LP5024_Table_SetRGBLEDBrightness(&table, 0, count, brightness) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(LP5024_Table_UpdateConfig(&table, 0, count, 0b1 << 5, 0) == LP5024_SUCCESS);
+	LP5024_TEST_CHECK(LP5024_Table_UpdateConfig(&table, 0, count, 0b1 << 5, 0) == LP5024_SUCCESS);
+	LP5024_Test_Traffic(&writes, &bytes);
+	LP5024_TEST_CHECK(writes == 2u * count);
+	LP5024_TEST_CHECK(Sim_Registers(&hi2c[0], 0x28)[LP5024_REG_CONFIG] == 0x1C);
+	LP5024_TEST_CHECK(Sim_Registers(&hi2c[0], 0x28)[LP5024_REG_BRIGHT_RGB_7] == 8);
+
+	/* Out of range. */
+	LP5024_TEST_CHECK(LP5024_Table_FillRGB(&table, 1, count, LP5024_RGB, 0, 0, 0) == LP5024_INPUTOUTOFRANGE);
+	LP5024_TEST_CHECK(LP5024_Table_SetLEDColourRGB(&table, count, LP5024_RGB, 0, 0, 0, 0) == LP5024_INPUTOUTOFRANGE);
+
+	/* Full panel update, render and flush. */
+	start = LP5024_Test_Nanoseconds();
+	for (uint32_t round = 0; round < LP5024_TEST_ROUNDS; round++)
+	{
+		LP5024_Table_FillRGB(&table, 0, count, LP5024_RGB, (uint8_t)round, 0, 0);
+		LP5024_Table_Flush(&table, 0, count);
+	}
+	printf("%2u chips: %.0f ns per panel update\n", count, (double)(LP5024_Test_Nanoseconds() - start) / LP5024_TEST_ROUNDS);
+}
+
+int main(void)
+{
+	lp5024_Handle_t handle;
+
+	printf("RAM per chip: %u bytes, table of %u chips: %u bytes\n", (unsigned)LP5024_TABLE_BYTES_PER_DEVICE,
+		   LP5024_TABLE_MAX_DEVICES, (unsigned)sizeof(lp5024_DeviceTable_t));
+	LP5024_Test_Panel(4);
+	LP5024_Test_Panel(16);
+	LP5024_Test_Panel(64);
+	LP5024_TEST_CHECK(LP5024_Table_Add(&table, &hi2c[0], LP5024_A1_GND_A0_GND, &handle) == LP5024_INPUTOUTOFRANGE);
+	return LP5024_TEST_RESULT();
+}
@@ -0,0 +1,46 @@
+/**
+ ******************************************************************************
+ * @file    LP5024_Test.h
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Checks and timing shared by the host tests of the LP5024 driver.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Every test is one executable run by ctest. Failed checks are printed with
+ * file and line, LP5024_TEST_RESULT() returns non zero if any check failed.
+ * Cost figures are printed for information only, checks use exact bus
+ * traffic of the simulated bus, see Stub/stm32f1xx_hal.h.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#ifndef LP5024_TEST_LP5024_TEST_H_
+#define LP5024_TEST_LP5024_TEST_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+static int LP5024_TestFailures;
+
+#define LP5024_TEST_CHECK(condition)                                             \
+	do                                                                           \
+	{                                                                            \
+		if (!(condition))                                                        \
+		{                                                                        \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			__atomic_fetch_add(&LP5024_TestFailures, 1, __ATOMIC_RELAXED);       \
+		}                                                                        \
+	} while (0)
+
+#define LP5024_TEST_RESULT() (LP5024_TestFailures ? (printf("%d check(s) failed\n", LP5024_TestFailures), 1) : 0)
+
+/* Monotonic host time for cost figures [ns]. */
+static inline uint64_t LP5024_Test_Nanoseconds(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+#endif /* LP5024_TEST_LP5024_TEST_H_ */
@@ -0,0 +1,367 @@
+/**
+ ******************************************************************************
+ * @file    stm32f1xx_hal.c
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Simulated I2C bus with LP50xx register files for host tests.
+ * @date 	Dec 7, 2023
+ ******************************************************************************
+ */
+
+#include "stm32f1xx_hal.h"
+#include <string.h>
+
+/* Transfer kinds of a pending job. */
+typedef enum
+{
+	Sim_JobNone,
+	Sim_JobMemWrite,
+	Sim_JobMemRead,
+	Sim_JobTransmit
+} Sim_Job_t;
+
+typedef struct
+{
+	I2C_HandleTypeDef *hi2c;
+	uint8_t reg[128][SIM_REG_COUNT]; // Register files by 7 bit address.
+	Sim_Job_t job;
+	uint8_t error; // Pending job ends in HAL_I2C_ErrorCallback.
+	uint16_t address;
+	uint16_t memAddress;
+	uint8_t *data;
+	uint16_t size;
+	HAL_StatusTypeDef fault;
+	uint32_t faultCount;
+	int inside;
+	Sim_Stats_t statistics;
+} Sim_Bus_t;
+
+static Sim_Bus_t Sim_Buses[SIM_BUSES];
+static uint32_t Sim_Tick;
+
+/* Returns the bus of a handle, the first free one on first use. */
+static Sim_Bus_t *Sim_Bus(I2C_HandleTypeDef *hi2c)
+{
+	for (uint8_t i = 0; i < SIM_BUSES; i++)
+	{
+		if (Sim_Buses[i].hi2c == hi2c)
+		{
+			return &Sim_Buses[i];
+		}
+	}
+	for (uint8_t i = 0; i < SIM_BUSES; i++)
+	{
+		if (Sim_Buses[i].hi2c == NULL)
+		{
+			Sim_Buses[i].hi2c = hi2c;
+			return &Sim_Buses[i];
+		}
+	}
+	return &Sim_Buses[SIM_BUSES - 1];
+}
+
+/* Register values after reset, LP5018/LP5024 layout, see datasheet. */
+static void Sim_ResetChip(uint8_t *reg)
+{
+	memset(reg, 0, SIM_REG_COUNT);
+	reg[0x01] = 0x3C;
+	reg[0x03] = 0xFF;
+	memset(&reg[0x07], 0xFF, 8);
+}
+
+/* Writes with auto increment as selected in CONFIG of the chip. */
+static void Sim_Write(Sim_Bus_t *bus, uint16_t address, uint16_t memAddress, const uint8_t *data, uint16_t size)
+{
+	uint8_t *reg = bus->reg[(address >> 1) & 0x7F];
+	for (uint16_t i = 0; i < size; i++)
+	{
+		reg[memAddress % SIM_REG_COUNT] = data[i];
+		if (reg[0x01] & (0b1 << 3))
+		{
+			memAddress++;
+		}
+	}
+	bus->statistics.writes++;
+	bus->statistics.bytes += size;
+}
+
+static void Sim_Read(Sim_Bus_t *bus, uint16_t address, uint16_t memAddress, uint8_t *data, uint16_t size)
+{
+	uint8_t *reg = bus->reg[(address >> 1) & 0x7F];
+	for (uint16_t i = 0; i < size; i++)
+	{
+		data[i] = reg[memAddress % SIM_REG_COUNT];
+		if (reg[0x01] & (0b1 << 3))
+		{
+			memAddress++;
+		}
+	}
+	bus->statistics.reads++;
+}
+
+/* Consumes one injected fault, returns HAL_OK if none is active. */
+static HAL_StatusTypeDef Sim_Fault(Sim_Bus_t *bus)
+{
+	if (bus->faultCount == 0)
+	{
+		return HAL_OK;
+	}
+	if (bus->faultCount != UINT32_MAX)
+	{
+		bus->faultCount--;
+	}
+	bus->statistics.faults++;
+	return bus->fault;
+}
+
+static Sim_Bus_t *Sim_Enter(I2C_HandleTypeDef *hi2c)
+{
+	Sim_Bus_t *bus = Sim_Bus(hi2c);
+	if (__atomic_fetch_add(&bus->inside, 1, __ATOMIC_ACQ_REL) != 0)
+	{
+		__atomic_fetch_add(&bus->statistics.overlaps, 1, __ATOMIC_RELAXED);
+	}
+	return bus;
+}
+
+static void Sim_Leave(Sim_Bus_t *bus)
+{
+	__atomic_fetch_sub(&bus->inside, 1, __ATOMIC_ACQ_REL);
+}
+
+/* Blocking transfer, busy and timeout cost the wait of the HAL. */
+static HAL_StatusTypeDef Sim_Blocking(I2C_HandleTypeDef *hi2c, Sim_Job_t job, uint16_t address, uint16_t memAddress, uint8_t *data, uint16_t size, uint32_t timeout)
+{
+	Sim_Bus_t *bus = Sim_Enter(hi2c);
+	HAL_StatusTypeDef status = HAL_BUSY;
+	bus->statistics.blocking++;
+	if (bus->job == Sim_JobNone)
+	{
+		status = Sim_Fault(bus);
+	}
+	if (status == HAL_BUSY)
+	{
+		Sim_Advance(SIM_BUSY_FLAG_TIMEOUT);
+	}
+	else if (status == HAL_TIMEOUT)
+	{
+		Sim_Advance(timeout);
+	}
+	else if (status == HAL_OK)
+	{
+		if (job == Sim_JobMemRead)
+		{
+			Sim_Read(bus, address, memAddress, data, size);
+		}
+		else
+		{
+			Sim_Write(bus, address, memAddress, data, size);
+		}
+	}
+	Sim_Leave(bus);
+	return status;
+}
+
+/* Starts a transfer completed by Sim_Complete, a NACK is reported by the error callback. */
+static HAL_StatusTypeDef Sim_Start(I2C_HandleTypeDef *hi2c, Sim_Job_t job, uint16_t address, uint16_t memAddress, uint8_t *data, uint16_t size)
+{
+	Sim_Bus_t *bus = Sim_Enter(hi2c);
+	HAL_StatusTypeDef status = HAL_BUSY;
+	if (bus->job == Sim_JobNone)
+	{
+		status = Sim_Fault(bus);
+	}
+	if (status == HAL_OK || status == HAL_ERROR)
+	{
+		bus->error = (status == HAL_ERROR);
+		bus->job = job;
+		bus->address = address;
+		bus->memAddress = memAddress;
+		bus->data = data;
+		bus->size = size;
+		status = HAL_OK;
+	}
+	Sim_Leave(bus);
+	return status;
+}
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c)
+{
+	Sim_Bus(hi2c)->statistics.inits++;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c)
+{
+	Sim_Bus_t *bus = Sim_Bus(hi2c);
+	bus->job = Sim_JobNone;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	(void)MemAddSize;
+	return Sim_Blocking(hi2c, Sim_JobMemWrite, DevAddress, MemAddress, pData, Size, Timeout);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	(void)MemAddSize;
+	return Sim_Blocking(hi2c, Sim_JobMemRead, DevAddress, MemAddress, pData, Size, Timeout);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size)
+{
+	(void)MemAddSize;
+	return Sim_Start(hi2c, Sim_JobMemWrite, DevAddress, MemAddress, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size)
+{
+	(void)MemAddSize;
+	return Sim_Start(hi2c, Sim_JobMemWrite, DevAddress, MemAddress, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size)
+{
+	(void)MemAddSize;
+	return Sim_Start(hi2c, Sim_JobMemRead, DevAddress, MemAddress, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	/* First byte is the register address. */
+	return Sim_Blocking(hi2c, Sim_JobTransmit, DevAddress, pData[0], pData + 1, Size - 1, Timeout);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size)
+{
+	return Sim_Start(hi2c, Sim_JobTransmit, DevAddress, pData[0], pData + 1, Size - 1);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size)
+{
+	return Sim_Start(hi2c, Sim_JobTransmit, DevAddress, pData[0], pData + 1, Size - 1);
+}
+
+HAL_I2C_StateTypeDef HAL_I2C_GetState(I2C_HandleTypeDef *hi2c)
+{
+	return (Sim_Bus(hi2c)->job == Sim_JobNone) ? HAL_I2C_STATE_READY : HAL_I2C_STATE_BUSY;
+}
+
+__attribute__((weak)) void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	(void)hi2c;
+}
+
+__attribute__((weak)) void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	(void)hi2c;
+}
+
+__attribute__((weak)) void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	(void)hi2c;
+}
+
+__attribute__((weak)) void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+	(void)hi2c;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+	Sim_Advance(Delay);
+}
+
+uint32_t HAL_GetTick(void)
+{
+	return __atomic_load_n(&Sim_Tick, __ATOMIC_RELAXED);
+}
+
+void Sim_Reset(void)
+{
+	memset(Sim_Buses, 0, sizeof(Sim_Buses));
+	for (uint8_t i = 0; i < SIM_BUSES; i++)
+	{
+		for (uint8_t address = 0; address < 128; address++)
+		{
+			Sim_ResetChip(Sim_Buses[i].reg[address]);
+		}
+	}
+	Sim_Tick = 0;
+}
+
+uint8_t *Sim_Registers(I2C_HandleTypeDef *hi2c, uint8_t address)
+{
+	return Sim_Bus(hi2c)->reg[address & 0x7F];
+}
+
+void Sim_InjectFault(I2C_HandleTypeDef *hi2c, HAL_StatusTypeDef status, uint32_t count)
+{
+	Sim_Bus_t *bus = Sim_Bus(hi2c);
+	bus->fault = status;
+	bus->faultCount = (status == HAL_OK) ? 0 : count;
+}
+
+uint8_t Sim_Complete(I2C_HandleTypeDef *hi2c)
+{
+	Sim_Bus_t *bus = NULL;
+	for (uint8_t i = 0; i < SIM_BUSES && bus == NULL; i++)
+	{
+		if (Sim_Buses[i].job != Sim_JobNone && (hi2c == NULL || Sim_Buses[i].hi2c == hi2c))
+		{
+			bus = &Sim_Buses[i];
+		}
+	}
+	if (bus == NULL)
+	{
+		return 0;
+	}
+	/* The HAL returns to ready before calling back, so callbacks may start the next transfer. */
+	Sim_Job_t job = bus->job;
+	bus->job = Sim_JobNone;
+	if (bus->error)
+	{
+		HAL_I2C_ErrorCallback(bus->hi2c);
+	}
+	else if (job == Sim_JobMemRead)
+	{
+		Sim_Read(bus, bus->address, bus->memAddress, bus->data, bus->size);
+		HAL_I2C_MemRxCpltCallback(bus->hi2c);
+	}
+	else
+	{
+		Sim_Write(bus, bus->address, bus->memAddress, bus->data, bus->size);
+		if (job == Sim_JobTransmit)
+		{
+			HAL_I2C_MasterTxCpltCallback(bus->hi2c);
+		}
+		else
+		{
+			HAL_I2C_MemTxCpltCallback(bus->hi2c);
+		}
+	}
+	return 1;
+}
+
+uint16_t Sim_Pending(I2C_HandleTypeDef *hi2c)
+{
+	Sim_Bus_t *bus = Sim_Bus(hi2c);
+	return (bus->job == Sim_JobNone) ? 0 : bus->size + 1;
+}
+
+void Sim_GetStats(I2C_HandleTypeDef *hi2c, Sim_Stats_t *statistics, uint8_t reset)
+{
+	Sim_Bus_t *bus = Sim_Bus(hi2c);
+	*statistics = bus->statistics;
+	if (reset)
+	{
+		memset(&bus->statistics, 0, sizeof(bus->statistics));
+	}
+}
+
+void Sim_Advance(uint32_t ticks)
+{
+	__atomic_fetch_add(&Sim_Tick, ticks, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,158 @@
+/**
+ ******************************************************************************
+ * @file    stm32f1xx_hal.h
+ * @version 1.0
+ * @author  Till Heuer - EVE Audio GmbH
+ * @brief   Host stub of the STM32 HAL parts used by the LP5024 driver.
+ * @date 	Dec 7, 2023
+ * @verbatim
+ * Transfers go to a simulated bus holding one LP50xx register file per I2C
+ * handle and 7 bit address. Auto increment follows bit 3 of CONFIG of the
+ * addressed chip for writes and reads.
+ *
+ * Blocking calls complete at once. DMA and interrupt calls stay pending
+ * until Sim_Complete(), which applies the transfer and calls the HAL
+ * completion callback like the interrupt handler would. The callbacks are
+ * weak and may be defined by the test.
+ *
+ * Faults are injected per handle with Sim_InjectFault(). Blocking calls
+ * answering HAL_BUSY or HAL_TIMEOUT advance the simulated tick by the time
+ * the HAL would have waited, so wasted bus time can be measured.
+ * @endverbatim
+ ******************************************************************************
+ */
+
+#ifndef LP5024_TEST_STUB_STM32F1XX_HAL_H_
+#define LP5024_TEST_STUB_STM32F1XX_HAL_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+	typedef enum
+	{
+		HAL_OK = 0x00,
+		HAL_ERROR = 0x01,
+		HAL_BUSY = 0x02,
+		HAL_TIMEOUT = 0x03
+	} HAL_StatusTypeDef;
+
+	typedef enum
+	{
+		HAL_I2C_STATE_RESET = 0x00,
+		HAL_I2C_STATE_READY = 0x20,
+		HAL_I2C_STATE_BUSY = 0x24
+	} HAL_I2C_StateTypeDef;
+
+	typedef struct
+	{
+		uint32_t CR1;
+	} I2C_TypeDef;
+
+	typedef struct
+	{
+		I2C_TypeDef *Instance;
+	} I2C_HandleTypeDef;
+
+#define I2C_MEMADD_SIZE_8BIT (0x00000001U)
+#define SIM_BUSY_FLAG_TIMEOUT (25U) ///< Wait of the HAL on a busy bus [ms].
+#define SIM_BUSES (16U)				///< Simulated I2C units.
+#define SIM_REG_COUNT (64U)			///< Registers per simulated chip.
+
+	/**
+	 * @brief Struct for traffic counters of one simulated bus.
+	 */
+	typedef struct
+	{
+		uint32_t writes;   ///< Completed write transactions.
+		uint32_t bytes;	   ///< Register bytes written.
+		uint32_t reads;	   ///< Completed read transactions.
+		uint32_t blocking; ///< Blocking calls, including failed ones.
+		uint32_t faults;   ///< Calls answered by an injected fault.
+		uint32_t overlaps; ///< Calls entered while another call on the same bus was running.
+		uint32_t inits;	   ///< HAL_I2C_Init calls.
+	} Sim_Stats_t;
+
+	// HAL
+	HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c);
+	HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c);
+	HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+	HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+	HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size);
+	HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size);
+	HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size);
+	HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+	HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+	HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size);
+	HAL_I2C_StateTypeDef HAL_I2C_GetState(I2C_HandleTypeDef *hi2c);
+	void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c);
+	void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c);
+	void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+	void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+	void HAL_Delay(uint32_t Delay);
+	uint32_t HAL_GetTick(void);
+
+	/* No interrupts on the host, completions run from Sim_Complete(). */
+	static inline uint32_t __get_PRIMASK(void) { return 0; }
+	static inline void __disable_irq(void) {}
+	static inline void __enable_irq(void) {}
+	static inline void __set_PRIMASK(uint32_t priMask) { (void)priMask; }
+
+	// Simulation
+	/**
+	 * @brief 					Clears all buses and sets every chip to its reset values.
+	 */
+	void Sim_Reset(void);
+	/**
+	 * @brief 					Returns the register file of a simulated chip.
+	 *
+	 * @param 	hi2c			Handle of the bus.
+	 * @param 	address			7 bit address of the chip.
+	 * @return 	uint8_t*		SIM_REG_COUNT registers.
+	 */
+	uint8_t *Sim_Registers(I2C_HandleTypeDef *hi2c, uint8_t address);
+	/**
+	 * @brief 					Answers the next calls on a bus with a status instead of transferring.
+	 *
+	 * @param 	hi2c			Handle of the bus.
+	 * @param 	status			Injected status, HAL_OK clears the fault.
+	 * @param 	count			Calls to answer, UINT32_MAX until cleared.
+	 */
+	void Sim_InjectFault(I2C_HandleTypeDef *hi2c, HAL_StatusTypeDef status, uint32_t count);
+	/**
+	 * @brief 					Completes the pending transfer of a bus and calls its HAL callback.
+	 *
+	 * @param 	hi2c			Handle of the bus, NULL for the first bus with a pending transfer.
+	 * @return 	uint8_t			1 if a transfer was completed, 0 if none was pending.
+	 */
+	uint8_t Sim_Complete(I2C_HandleTypeDef *hi2c);
+	/**
+	 * @brief 					Returns the length of the pending transfer of a bus.
+	 *
+	 * @param 	hi2c			Handle of the bus.
+	 * @return 	uint16_t		Bytes including the register byte, 0 if idle.
+	 */
+	uint16_t Sim_Pending(I2C_HandleTypeDef *hi2c);
+	/**
+	 * @brief 					Copies the traffic counters of a bus.
+	 *
+	 * @param 	hi2c			Handle of the bus.
+	 * @param 	statistics		Destination.
+	 * @param 	reset			Resets counters after copying if non zero.
+	 */
+	void Sim_GetStats(I2C_HandleTypeDef *hi2c, Sim_Stats_t *statistics, uint8_t reset);
+	/**
+	 * @brief 					Advances the simulated millisecond tick.
+	 *
+	 * @param 	ticks			Milliseconds to advance.
+	 */
+	void Sim_Advance(uint32_t ticks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LP5024_TEST_STUB_STM32F1XX_HAL_H_ */
@@ -0,0 +1,92 @@
+#!/bin/sh
+# ******************************************************************************
+# @file    size_report.sh
+# @version 1.0
+# @author  Till Heuer - EVE Audio GmbH
+# @brief   Flash footprint of the LP5024 driver per file and per function.
+# @date    Dec 7, 2023
+#
+# Compiles every Src/*.c on its own with one section per function and lists
+# .text, .rodata, .data and .bss per file, then every function and constant
+# by size. Nothing is linked, so the figures are the driver alone, without
+# HAL and C library.
+#
+# Usage, from any directory:
+# Tools/size_report.sh                     host gcc, HAL from Test/Stub
+# Tools/size_report.sh 6edae71^            Src and Inc of a git revision
+# CC=arm-none-eabi-gcc CFLAGS="-mcpu=cortex-m0 -mthumb -Os" Tools/size_report.sh
+# FLASH_BUDGET=16384 Tools/size_report.sh  fails if .text + .rodata + .data exceed it
+#
+# CC, CFLAGS, NM and SIZE may be overridden. NM and SIZE default to the tools
+# of the CC prefix. Includes are Inc and Test/Stub, the stub HAL declares the
+# same functions as the STM32 HAL, so the driver code is the same. A revision
+# is taken with its own Src and Inc and the Test/Stub of the working tree.
+# ******************************************************************************
+
+set -eu
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+CC=${CC:-gcc}
+CFLAGS=${CFLAGS:--Os}
+PREFIX=${CC%gcc}
+NM=${NM:-${PREFIX}nm}
+SIZE=${SIZE:-${PREFIX}size}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+TREE=$ROOT
+REVISION=${1:-}
+if [ -n "$REVISION" ]; then
+	TREE=$WORK/tree
+	mkdir "$TREE"
+	git -C "$ROOT" archive "$REVISION" Src Inc | tar -x -C "$TREE"
+fi
+
+echo "# LP5024 driver size report"
+echo "# CC:     $CC ($($CC -dumpmachine), $($CC -dumpversion))"
+echo "# CFLAGS: $CFLAGS -ffunction-sections -fdata-sections"
+echo "# Tree:   ${REVISION:-working tree}"
+echo
+printf '%-24s %7s %7s %7s %7s\n' file .text .rodata .data .bss
+
+for source in "$TREE"/Src/*.c; do
+	name=$(basename "$source" .c)
+	# shellcheck disable=SC2086 # CFLAGS holds several options.
+	$CC $CFLAGS -std=gnu99 -ffunction-sections -fdata-sections -I "$TREE/Inc" -I "$ROOT/Test/Stub" -c "$source" -o "$WORK/$name.o"
+	# Sums the sections of one function or object back to their kind.
+	$SIZE -A "$WORK/$name.o" | awk -v name="$name.c" '
+		$1 ~ /^\.text/ { text += $2 }
+		$1 ~ /^\.rodata/ { rodata += $2 }
+		$1 ~ /^\.data/ { data += $2 }
+		$1 ~ /^\.bss/ { bss += $2 }
+		END { printf "%-24s %7d %7d %7d %7d\n", name, text, rodata, data, bss }'
+	# Symbols with size: address, size, type, name.
+	$NM -S --size-sort "$WORK/$name.o" | awk -v file="$name.c" '
+		function hex(value, i, result) {
+			result = 0
+			for (i = 1; i <= length(value); i++)
+				result = result * 16 + index("0123456789abcdef", tolower(substr(value, i, 1))) - 1
+			return result
+		}
+		NF == 4 {
+			kind = ($3 ~ /[Tt]/) ? ".text" : ($3 ~ /[Rr]/) ? ".rodata" : ($3 ~ /[Dd]/) ? ".data" : ".bss"
+			printf "%d %s %s %s\n", hex($2), kind, $4, file
+		}' >>"$WORK/symbols"
+done | tee "$WORK/files"
+
+awk '{ text += $2; rodata += $3; data += $4; bss += $5 }
+	END { printf "%-24s %7d %7d %7d %7d\n", "total", text, rodata, data, bss }' "$WORK/files" | tee "$WORK/total"
+
+echo
+echo "# Functions and constants by size"
+printf '%7s %-8s %-40s %s\n' bytes section symbol file
+sort -k1,1nr -k3,3 "$WORK/symbols" | awk '{ printf "%7d %-8s %-40s %s\n", $1, $2, $3, $4 }'
+
+if [ -n "${FLASH_BUDGET:-}" ]; then
+	flash=$(awk '{ print $2 + $3 + $4 }' "$WORK/total")
+	echo
+	echo "# Flash $flash of $FLASH_BUDGET bytes"
+	if [ "$flash" -gt "$FLASH_BUDGET" ]; then
+		echo "# Over budget by $((flash - FLASH_BUDGET)) bytes" >&2
+		exit 1
+	fi
+fi